@@ -0,0 +1,283 @@
+#include "bench/bench.h"
+#include <algorithm>  // min()
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts every heap allocation made by the process, on any thread.
+static std::atomic<std::size_t> allocCount{0};
+
+void* operator new(std::size_t bytes)
+{
+    ++allocCount;
+    void* p = std::malloc(bytes == 0 ? 1 : bytes);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void* operator new[](std::size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void operator delete[](void* p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace bench
+{
+
+namespace
+{
+
+std::vector<Case>& registry()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+volatile const void* sink;
+
+struct Result
+{
+    const Case* c;
+    long calls;          // calls in the fastest batch
+    double seconds;      // per call, fastest batch
+    double allocs;       // heap allocations per call
+};
+
+/**
+ * Times op in batches, each long enough to exceed minTime seconds, and
+ * keeps the fastest batch, which is the least disturbed by other work.
+ */
+Result measure(const Case& c, double minTime, int batches)
+{
+    using Clock = std::chrono::steady_clock;
+    std::function<void()> op = c.setup();
+    op();  // warm up caches and any lazily built state
+
+    long calls = 1;
+    double best = 0.0;
+    long bestCalls = 1;
+    std::size_t bestAllocs = 0;
+    for (int b = 0; b < batches; ++b)
+    {
+        double elapsed;
+        std::size_t allocs;
+        for (;;)
+        {
+            std::size_t a0 = allocCount;
+            Clock::time_point t0 = Clock::now();
+            for (long i = 0; i < calls; ++i)
+            {
+                op();
+            }
+            elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+            allocs = allocCount - a0;
+            if (elapsed >= minTime || b > 0)
+            {
+                break;
+            }
+            calls *= 2;
+        }
+        if (b == 0 || elapsed / calls < best / bestCalls)
+        {
+            best = elapsed;
+            bestCalls = calls;
+            bestAllocs = allocs;
+        }
+    }
+    return {&c, bestCalls, best / bestCalls,
+            static_cast<double>(bestAllocs) / bestCalls};
+}
+
+void printCsvHeader()
+{
+    std::printf("name,size,calls,ns_per_call,gflops,gbytes_per_s,"
+                "allocs_per_call\n");
+}
+
+void printCsv(const Result& r)
+{
+    std::printf("%s,%d,%ld,%.1f,", r.c->name.c_str(), r.c->size, r.calls,
+                r.seconds * 1e9);
+    if (r.c->flops > 0)
+    {
+        std::printf("%.3f", r.c->flops / r.seconds * 1e-9);
+    }
+    std::printf(",");
+    if (r.c->bytes > 0)
+    {
+        std::printf("%.3f", r.c->bytes / r.seconds * 1e-9);
+    }
+    std::printf(",%.2f\n", r.allocs);
+}
+
+void printJson(const Result& r, bool first)
+{
+    std::printf("%s\n  {\"name\": \"%s\", \"size\": %d, \"calls\": %ld, "
+                "\"ns_per_call\": %.1f, ",
+                first ? "" : ",", r.c->name.c_str(), r.c->size, r.calls,
+                r.seconds * 1e9);
+    if (r.c->flops > 0)
+    {
+        std::printf("\"gflops\": %.3f, ", r.c->flops / r.seconds * 1e-9);
+    }
+    else
+    {
+        std::printf("\"gflops\": null, ");
+    }
+    if (r.c->bytes > 0)
+    {
+        std::printf("\"gbytes_per_s\": %.3f, ", r.c->bytes / r.seconds * 1e-9);
+    }
+    else
+    {
+        std::printf("\"gbytes_per_s\": null, ");
+    }
+    std::printf("\"allocs_per_call\": %.2f}", r.allocs);
+}
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--format=csv|json] [--filter=SUBSTRING] "
+                 "[--max-size=N] [--min-time=SECONDS] [--batches=N] "
+                 "[--list]\n",
+                 prog);
+}
+
+}  // namespace
+
+void add(const std::string& name, const std::vector<int>& sizes,
+         std::function<double(int)> flops, std::function<double(int)> bytes,
+         std::function<std::function<void()>(int)> setup)
+{
+    for (int n : sizes)
+    {
+        registry().push_back({name, n, flops(n), bytes(n),
+                              [setup, n]() { return setup(n); }});
+    }
+}
+
+void consume(const void* p)
+{
+    sink = p;
+}
+
+}  // namespace bench
+
+/**
+ * Runs the registered benchmarks and writes one record per case to
+ * stdout, as CSV (the default) or as a JSON array.
+ */
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    bool list = false;
+    std::string filter;
+    int maxSize = 0;
+    double minTime = 0.05;
+    int batches = 5;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--format=json") == 0)
+        {
+            json = true;
+        }
+        else if (std::strcmp(arg, "--format=csv") == 0)
+        {
+            json = false;
+        }
+        else if (std::strncmp(arg, "--filter=", 9) == 0)
+        {
+            filter = arg + 9;
+        }
+        else if (std::strncmp(arg, "--max-size=", 11) == 0)
+        {
+            maxSize = std::atoi(arg + 11);
+        }
+        else if (std::strncmp(arg, "--min-time=", 11) == 0)
+        {
+            minTime = std::atof(arg + 11);
+        }
+        else if (std::strncmp(arg, "--batches=", 10) == 0)
+        {
+            batches = std::max(1, std::atoi(arg + 10));
+        }
+        else if (std::strcmp(arg, "--list") == 0)
+        {
+            list = true;
+        }
+        else
+        {
+            bench::usage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench::registerKernels();
+    bool first = true;
+    if (json && !list)
+    {
+        std::printf("[");
+    }
+    else if (!list)
+    {
+        bench::printCsvHeader();
+    }
+    for (const bench::Case& c : bench::registry())
+    {
+        if (c.name.find(filter) == std::string::npos
+            || (maxSize > 0 && c.size > maxSize))
+        {
+            continue;
+        }
+        if (list)
+        {
+            std::printf("%s %d\n", c.name.c_str(), c.size);
+            continue;
+        }
+        bench::Result r = bench::measure(c, minTime, batches);
+        if (json)
+        {
+            bench::printJson(r, first);
+        }
+        else
+        {
+            bench::printCsv(r);
+        }
+        std::fflush(stdout);
+        first = false;
+    }
+    if (json && !list)
+    {
+        std::printf("\n]\n");
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * Case: one benchmark at one problem size. setup() runs once, untimed,
+ * and returns the operation to time. flops and bytes are the work and
+ * memory traffic of one call, used to derive GFLOP/s and GB/s; zero means
+ * not meaningful for this case.
+ */
+struct Case
+{
+    std::string name;
+    int size;
+    double flops;
+    double bytes;
+    std::function<std::function<void()>()> setup;
+};
+
+// Registers a benchmark family with the harness, one case per size.
+void add(const std::string& name, const std::vector<int>& sizes,
+         std::function<double(int)> flops, std::function<double(int)> bytes,
+         std::function<std::function<void()>(int)> setup);
+
+// Keeps the compiler from discarding a result.
+void consume(const void* p);
+
+// Registers the library's benchmarks; defined in kernels.cpp.
+void registerKernels();
+
+}  // namespace bench
@@ -0,0 +1,381 @@
+#include "bench/bench.h"
+#include "inc/gauss.h"
+#include "inc/krylov.h"
+#include "inc/linop.h"
+#include "inc/matrix.h"
+#include "inc/refine.h"
+#include "inc/sparse.h"
+#include "inc/splu.h"
+#include "inc/vector.h"
+#include "inc/view.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const std::size_t F = sizeof(float);
+
+double zero(int)
+{
+    return 0.0;
+}
+
+// Well-conditioned dense test matrix: random with a dominant diagonal.
+la::Matrix diagonallyDominant(int n)
+{
+    la::Matrix A = la::Matrix::random(n, n, -1.0F, 1.0F);
+    for (int i = 0; i < n; ++i)
+    {
+        A(i, i) += n;
+    }
+    return A;
+}
+
+// Five-point Laplacian on a k x k grid, of order k^2.
+la::SparseMatrix laplacian(int k)
+{
+    std::vector<int> rows, cols;
+    std::vector<float> vals;
+    auto add = [&](int i, int j, float v)
+    {
+        rows.push_back(i);
+        cols.push_back(j);
+        vals.push_back(v);
+    };
+    for (int y = 0; y < k; ++y)
+    {
+        for (int x = 0; x < k; ++x)
+        {
+            int i = y * k + x;
+            add(i, i, 4.0F);
+            if (x > 0)
+            {
+                add(i, i - 1, -1.0F);
+            }
+            if (x < k - 1)
+            {
+                add(i, i + 1, -1.0F);
+            }
+            if (y > 0)
+            {
+                add(i, i - k, -1.0F);
+            }
+            if (y < k - 1)
+            {
+                add(i, i + k, -1.0F);
+            }
+        }
+    }
+    return la::SparseMatrix::fromTriplets(k * k, k * k, rows, cols, vals);
+}
+
+const std::vector<int> VECTOR_SIZES{1000, 10000, 100000, 1000000};
+const std::vector<int> DENSE_SIZES{32, 64, 128, 256, 512, 1024};
+const std::vector<int> FACTOR_SIZES{16, 32, 64, 128, 256};
+const std::vector<int> GRID_SIZES{8, 16, 32};
+
+/**
+ * Registers a Krylov solver benchmark on the grid Laplacian. Solver is
+ * constructed once per case, as the solvers are meant to be reused.
+ */
+template <typename Solver>
+void addKrylov(const char* name)
+{
+    bench::add(
+        name, GRID_SIZES, zero, zero,
+        [](int k)
+        {
+            int n = k * k;
+            auto A = std::make_shared<la::SparseMatrix>(laplacian(k));
+            auto op = std::make_shared<la::SparseOperator>(*A);
+            auto solver = std::make_shared<Solver>(n);
+            auto b = std::make_shared<la::Vector>(n, 1.0F);
+            auto x = std::make_shared<la::Vector>(n, 0.0F);
+            return std::function<void()>([A, op, solver, b, x]()
+            {
+                la::fill(*x, 0.0F);
+                solver->solve(*op, *b, *x);
+                bench::consume(x->begin());
+            });
+        });
+}
+
+}  // namespace
+
+namespace bench
+{
+
+/**
+ * Registers the library's benchmarks. Flop counts for factorizations are
+ * the leading terms of the usual estimates; solver cases report time only.
+ */
+void registerKernels()
+{
+    bench::add(
+        "vector_add", VECTOR_SIZES,
+        [](int n) { return 1.0 * n; },
+        [](int n) { return 3.0 * n * F; },
+        [](int n)
+        {
+            auto v = std::make_shared<la::Vector>(la::Vector::random(n));
+            auto w = std::make_shared<la::Vector>(la::Vector::random(n));
+            return std::function<void()>([v, w]()
+            {
+                la::Vector s = *v + *w;
+                bench::consume(&s[0]);
+            });
+        });
+
+    bench::add(
+        "axpy", VECTOR_SIZES,
+        [](int n) { return 2.0 * n; },
+        [](int n) { return 3.0 * n * F; },
+        [](int n)
+        {
+            auto x = std::make_shared<la::Vector>(la::Vector::random(n));
+            auto y = std::make_shared<la::Vector>(la::Vector::random(n));
+            return std::function<void()>([x, y]()
+            {
+                la::axpy(1e-3F, *x, *y);
+                bench::consume(y->begin());
+            });
+        });
+
+    bench::add(
+        "dot", VECTOR_SIZES,
+        [](int n) { return 2.0 * n; },
+        [](int n) { return 2.0 * n * F; },
+        [](int n)
+        {
+            auto x = std::make_shared<la::Vector>(la::Vector::random(n));
+            auto y = std::make_shared<la::Vector>(la::Vector::random(n));
+            return std::function<void()>([x, y]()
+            {
+                volatile float d = la::dot(*x, *y);
+                (void)d;
+            });
+        });
+
+    bench::add(
+        "approx_equal", VECTOR_SIZES,
+        zero,
+        [](int n) { return 2.0 * n * F; },
+        [](int n)
+        {
+            auto x = std::make_shared<la::Vector>(la::Vector::random(n));
+            auto y = std::make_shared<la::Vector>(*x);
+            return std::function<void()>([x, y]()
+            {
+                volatile bool equal = la::approxEqual(*x, *y);
+                (void)equal;
+            });
+        });
+
+    bench::add(
+        "gemv", DENSE_SIZES,
+        [](int n) { return 2.0 * n * n; },
+        [](int n) { return (1.0 * n * n + 2.0 * n) * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto x = std::make_shared<la::Vector>(la::Vector::random(n));
+            auto y = std::make_shared<la::Vector>(n, 0.0F);
+            return std::function<void()>([A, x, y]()
+            {
+                la::gemv(1.0F, *A, *x, 0.0F, *y);
+                bench::consume(y->begin());
+            });
+        });
+
+    bench::add(
+        "gemm", DENSE_SIZES,
+        [](int n) { return 2.0 * n * n * n; },
+        [](int n) { return 4.0 * n * n * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto B = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto C = std::make_shared<la::Matrix>(n, n, 0.0F);
+            return std::function<void()>([A, B, C]()
+            {
+                la::gemm(la::Op::NoTrans, la::Op::NoTrans, 1.0F, *A, *B, 0.0F,
+                         *C);
+                bench::consume(C->data());
+            });
+        });
+
+    bench::add(
+        "gemm_tn", DENSE_SIZES,
+        [](int n) { return 2.0 * n * n * n; },
+        [](int n) { return 4.0 * n * n * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto B = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto C = std::make_shared<la::Matrix>(n, n, 0.0F);
+            return std::function<void()>([A, B, C]()
+            {
+                la::gemm(la::Op::Trans, la::Op::NoTrans, 1.0F, *A, *B, 1.0F,
+                         *C);
+                bench::consume(C->data());
+            });
+        });
+
+    bench::add(
+        "matrix_multiply", DENSE_SIZES,
+        [](int n) { return 2.0 * n * n * n; },
+        [](int n) { return 3.0 * n * n * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto B = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            return std::function<void()>([A, B]()
+            {
+                la::Matrix C = *A * *B;
+                bench::consume(C.data());
+            });
+        });
+
+    bench::add(
+        "transpose", {64, 256, 1024, 2048, 4096},
+        zero,
+        [](int n) { return 2.0 * n * n * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            auto AT = std::make_shared<la::Matrix>(n, n);
+            return std::function<void()>([A, AT]()
+            {
+                la::transpose(*A, *AT);
+                bench::consume(AT->data());
+            });
+        });
+
+    bench::add(
+        "transpose_in_place", {64, 256, 1024, 2048, 4096},
+        zero,
+        [](int n) { return 2.0 * n * n * F; },
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(la::Matrix::random(n, n));
+            return std::function<void()>([A]()
+            {
+                la::transposeInPlace(*A);
+                bench::consume(A->data());
+            });
+        });
+
+    bench::add(
+        "factor", FACTOR_SIZES,
+        [](int n) { return 2.0 / 3.0 * n * n * n; },
+        zero,
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(diagonallyDominant(n));
+            auto L = std::make_shared<la::Matrix>(n, n);
+            auto U = std::make_shared<la::Matrix>(n, n);
+            return std::function<void()>([A, L, U]()
+            {
+                la::factor(*A, la::partialPivotSelector, *L, *U);
+                bench::consume(U->data());
+            });
+        });
+
+    bench::add(
+        "lu_factor", FACTOR_SIZES,
+        [](int n) { return 2.0 / 3.0 * n * n * n; },
+        zero,
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(diagonallyDominant(n));
+            auto LU = std::make_shared<la::Matrix>(n, n);
+            auto piv = std::make_shared<std::vector<int>>();
+            return std::function<void()>([A, LU, piv]()
+            {
+                *LU = *A;
+                la::luFactor(*LU, *piv);
+                bench::consume(LU->data());
+            });
+        });
+
+    bench::add(
+        "eliminate", FACTOR_SIZES,
+        [](int n) { return 1.0 * n * n * n; },
+        zero,
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(diagonallyDominant(n));
+            auto R = std::make_shared<la::Matrix>(n, n);
+            return std::function<void()>([A, R]()
+            {
+                *R = *A;
+                la::eliminate(*R, la::partialPivotSelector);
+                bench::consume(R->data());
+            });
+        });
+
+    bench::add(
+        "inverse", FACTOR_SIZES,
+        [](int n) { return 2.0 * n * n * n; },
+        zero,
+        [](int n)
+        {
+            auto A = std::make_shared<la::Matrix>(diagonallyDominant(n));
+            auto AInv = std::make_shared<la::Matrix>(n, n);
+            return std::function<void()>([A, AInv]()
+            {
+                la::inverse(*A, *AInv);
+                bench::consume(AInv->data());
+            });
+        });
+
+    bench::add(
+        "mixed_precision_solve", FACTOR_SIZES,
+        [](int n) { return 2.0 / 3.0 * n * n * n; },
+        zero,
+        [](int n)
+        {
+            la::BasicMatrix<double> A(n, n);
+            la::Matrix Af = diagonallyDominant(n);
+            for (int j = 0; j < n; ++j)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    A(i, j) = Af(i, j);
+                }
+            }
+            auto b = std::make_shared<la::BasicVector<double>>(n, 1.0);
+            auto x = std::make_shared<la::BasicVector<double>>(n, 0.0);
+            return std::function<void()>([A, b, x]()
+            {
+                la::MixedPrecisionSolver solver(A);
+                solver.solve(*b, *x);
+                bench::consume(x->begin());
+            });
+        });
+
+    addKrylov<la::ConjugateGradient>("cg_laplacian");
+    addKrylov<la::GMRES>("gmres_laplacian");
+    addKrylov<la::BiCGSTAB>("bicgstab_laplacian");
+
+    bench::add(
+        "sparse_lu_laplacian", GRID_SIZES, zero, zero,
+        [](int k)
+        {
+            int n = k * k;
+            auto A = std::make_shared<la::SparseMatrix>(laplacian(k));
+            auto lu = std::make_shared<la::SparseLU>();
+            lu->analyze(*A);
+            auto b = std::make_shared<la::Vector>(n, 1.0F);
+            auto x = std::make_shared<la::Vector>(n, 0.0F);
+            return std::function<void()>([A, lu, b, x]()
+            {
+                lu->factor(*A);
+                lu->solve(*b, *x);
+                bench::consume(x->begin());
+            });
+        });
+}
+
+}  // namespace bench
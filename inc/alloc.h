@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace la
+{
+
+// Alignment, in bytes, of all storage from allocate(): one cache line.
+const std::size_t ALIGNMENT = 64;
+
+/**
+ * Workspace: while a Workspace is alive, storage that Vectors and Matrices
+ * allocate on the same thread is carved from a thread-local arena instead
+ * of the heap, and all of it is released at once when the Workspace is
+ * destroyed. The arena keeps its memory between Workspaces, so repeating
+ * the same computation in a fresh Workspace does not touch the heap.
+ * Workspaces nest. Objects allocated in a Workspace must not outlive it or
+ * be destroyed on another thread.
+ */
+class Workspace
+{
+public:
+    Workspace();
+    ~Workspace();
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    static void reserve(std::size_t bytes);
+    static std::size_t capacity();
+    static std::size_t used();
+
+private:
+    std::size_t _chunk;   // arena chunk in use when the Workspace began
+    std::size_t _offset;  // offset into that chunk
+};
+
+// Central allocator for Vector and Matrix storage
+void* allocate(std::size_t bytes);
+void deallocate(void* p, std::size_t bytes);
+std::size_t heapAllocations();
+int leadingDimension(int rows, std::size_t scalarSize);
+
+/**
+ * Allocates uninitialized storage for n objects of type T from the
+ * current Workspace, if any, and otherwise from the heap.
+ */
+template <typename T>
+T* allocateArray(std::size_t n)
+{
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "arena storage is released without running destructors");
+    return static_cast<T*>(allocate(n * sizeof(T)));
+}
+
+template <typename T>
+void deallocateArray(T* p, std::size_t n)
+{
+    deallocate(p, n * sizeof(T));
+}
+
+}  // namespace la
@@ -8,7 +8,8 @@ namespace la
  * that exist elsewhere. Supports addition and iteration
  * but not deletion. Objects added by reference are freed
  * by the caller, while objects added by pointer are freed
- * by the Bag.
+ * by the Bag. Vectors of one length are better kept contiguously in a
+ * VectorPool (inc/pool.h).
  */
 template <typename T>
 class Bag
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "inc/mapped.h"
+#include "inc/view.h"
+#include <complex>
+#include <cstdint>
+#include <string>
+
+namespace la
+{
+
+/**
+ * Binary matrix files hold a 64-byte BinaryHeader followed by the entries
+ * in column-major order, each column padded to ld entries. The entries
+ * start dataOffset bytes into the file, a multiple of ALIGNMENT, so a
+ * mapped file can be used in place.
+ */
+struct BinaryHeader
+{
+    char magic[8];            // "LAMATRIX"
+    std::uint32_t version;    // BINARY_VERSION
+    std::uint32_t byteOrder;  // 0x01020304 as written by the host
+    std::uint32_t dtype;      // BinaryType of the entries
+    std::uint32_t layout;     // 0: column-major
+    std::int64_t rows;
+    std::int64_t cols;
+    std::int64_t ld;
+    std::uint64_t dataOffset;
+    std::uint64_t checksum;   // FNV-1a of the ld * cols entries
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "binary header must be 64 bytes");
+
+const std::uint32_t BINARY_VERSION = 1;
+
+enum class BinaryType : std::uint32_t
+{
+    Float32 = 1,
+    Float64 = 2,
+    Complex64 = 3,
+    Complex128 = 4
+};
+
+// BinaryTypeOf<T>::value: the BinaryType of entries of type T.
+template <typename T>
+struct BinaryTypeOf;
+
+template <>
+struct BinaryTypeOf<float>
+{
+    static constexpr BinaryType value = BinaryType::Float32;
+};
+
+template <>
+struct BinaryTypeOf<double>
+{
+    static constexpr BinaryType value = BinaryType::Float64;
+};
+
+template <>
+struct BinaryTypeOf<std::complex<float>>
+{
+    static constexpr BinaryType value = BinaryType::Complex64;
+};
+
+template <>
+struct BinaryTypeOf<std::complex<double>>
+{
+    static constexpr BinaryType value = BinaryType::Complex128;
+};
+
+template <typename T>
+bool writeBinary(const std::string& path, const BasicConstMatrixView<T>& A);
+
+/**
+ * BasicMappedMatrix: a read-only matrix whose entries are those of a
+ * binary matrix file, or of a column-major (Fortran-order) .npy file,
+ * mapped into memory, so opening it reads nothing but the header. The
+ * file must not change while it is open.
+ */
+template <typename T>
+class BasicMappedMatrix : public BasicConstMatrixView<T>
+{
+public:
+    BasicMappedMatrix();
+    BasicMappedMatrix(const BasicMappedMatrix&) = delete;
+    BasicMappedMatrix(BasicMappedMatrix&& A);
+    ~BasicMappedMatrix();
+
+    BasicMappedMatrix& operator=(const BasicMappedMatrix&) = delete;
+    BasicMappedMatrix& operator=(BasicMappedMatrix&& A);
+
+    bool open(const std::string& path, bool verify = false);
+    void close();
+    bool isOpen() const;
+
+private:
+    using BasicConstMatrixView<T>::_p;
+    using BasicConstMatrixView<T>::_m;
+    using BasicConstMatrixView<T>::_n;
+    using BasicConstMatrixView<T>::_ld;
+
+    MappedFile _file;
+};
+
+using MappedMatrix = BasicMappedMatrix<float>;
+
+}  // namespace la
@@ -0,0 +1,403 @@
+#pragma once
+
+#include "inc/util.h"
+#include "inc/vector.h"
+#include "inc/matrix.h"
+#include <cassert>
+#include <initializer_list>
+#include <iostream>
+
+namespace la
+{
+
+/**
+ * Unroll: calls f(0), f(1), ..., f(N - 1) by compile-time recursion, so
+ * loops over fixed dimensions are fully unrolled once inlined.
+ */
+template <int N>
+struct Unroll
+{
+    template <typename F>
+    static void apply(F&& f)
+    {
+        Unroll<N - 1>::apply(f);
+        f(N - 1);
+    }
+};
+
+template <>
+struct Unroll<0>
+{
+    template <typename F>
+    static void apply(F&&)
+    {}
+};
+
+/**
+ * FixedVector: a Vector whose length N is known at compile time.
+ * Entries are stored inline, so FixedVectors never touch the heap.
+ */
+template <int N, typename T = float>
+class FixedVector
+{
+    static_assert(N > 0, "FixedVector must have at least one entry");
+
+public:
+    using value_type = T;
+
+    FixedVector()
+    {}
+
+    explicit FixedVector(T initVal)
+    {
+        Unroll<N>::apply([&](int i) { _e[i] = initVal; });
+    }
+
+    FixedVector(std::initializer_list<T> list)
+    {
+        assert(list.size() == N);
+        int i = 0;
+        for (T val : list)
+        {
+            _e[i++] = val;
+        }
+    }
+
+    explicit FixedVector(const BasicVector<T>& v)
+    {
+        assert(v.size() == N);
+        Unroll<N>::apply([&](int i) { _e[i] = v[i]; });
+    }
+
+    FixedVector& operator+=(const FixedVector& v)
+    {
+        Unroll<N>::apply([&](int i) { _e[i] += v._e[i]; });
+        return *this;
+    }
+
+    FixedVector& operator-=(const FixedVector& v)
+    {
+        Unroll<N>::apply([&](int i) { _e[i] -= v._e[i]; });
+        return *this;
+    }
+
+    FixedVector& operator*=(T x)
+    {
+        Unroll<N>::apply([&](int i) { _e[i] *= x; });
+        return *this;
+    }
+
+    T& operator[](int i)
+    {
+        assert(i >= 0 && i < N);
+        return _e[i];
+    }
+
+    const T& operator[](int i) const
+    {
+        assert(i >= 0 && i < N);
+        return _e[i];
+    }
+
+    T* begin() { return _e; }
+    const T* begin() const { return _e; }
+    T* end() { return _e + N; }
+    const T* end() const { return _e + N; }
+
+    static constexpr int size() { return N; }
+
+    BasicVector<T> toVector() const
+    {
+        BasicVector<T> v(N);
+        Unroll<N>::apply([&](int i) { v[i] = _e[i]; });
+        return v;
+    }
+
+private:
+    T _e[N];
+};
+
+template <int N, typename T>
+bool operator==(const FixedVector<N, T>& v, const FixedVector<N, T>& w)
+{
+    bool equal = true;
+    Unroll<N>::apply([&](int i) { equal = equal && v[i] == w[i]; });
+    return equal;
+}
+
+template <int N, typename T>
+bool operator!=(const FixedVector<N, T>& v, const FixedVector<N, T>& w)
+{
+    return !(v == w);
+}
+
+template <int N, typename T>
+FixedVector<N, T> operator+(FixedVector<N, T> v, const FixedVector<N, T>& w)
+{
+    return v += w;
+}
+
+template <int N, typename T>
+FixedVector<N, T> operator-(FixedVector<N, T> v, const FixedVector<N, T>& w)
+{
+    return v -= w;
+}
+
+template <int N, typename T>
+FixedVector<N, T> operator*(FixedVector<N, T> v,
+                            typename FixedVector<N, T>::value_type x)
+{
+    return v *= x;
+}
+
+template <int N, typename T>
+FixedVector<N, T> operator*(typename FixedVector<N, T>::value_type x,
+                            FixedVector<N, T> v)
+{
+    return v *= x;
+}
+
+template <int N, typename T>
+T dot(const FixedVector<N, T>& v, const FixedVector<N, T>& w)
+{
+    T sum = T(0);
+    Unroll<N>::apply([&](int i) { sum += v[i] * w[i]; });
+    return sum;
+}
+
+template <int N, typename T>
+std::ostream& operator<<(std::ostream& os, const FixedVector<N, T>& v)
+{
+    os << "(";
+    for (int i = 0; i < N; ++i)
+    {
+        os << (i > 0 ? ", " : "") << v[i];
+    }
+    os << ")";
+    return os;
+}
+
+template <int N, typename T>
+bool approxEqual(const FixedVector<N, T>& v, const FixedVector<N, T>& w,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon())
+{
+    bool equal = true;
+    Unroll<N>::apply([&](int i)
+    {
+        equal = equal && approxEqual(v[i], w[i], epsilon);
+    });
+    return equal;
+}
+
+template <int N, typename T>
+FixedVector<N + 1, T> homogenize(const FixedVector<N, T>& v)
+{
+    FixedVector<N + 1, T> w;
+    Unroll<N>::apply([&](int i) { w[i] = v[i]; });
+    w[N] = T(1);
+    return w;
+}
+
+template <int N, typename T>
+FixedVector<N - 1, T> dehomogenize(const FixedVector<N, T>& v)
+{
+    assert(v[N - 1] != T(0));
+    T inv = T(1) / v[N - 1];
+    FixedVector<N - 1, T> w;
+    Unroll<N - 1>::apply([&](int i) { w[i] = v[i] * inv; });
+    return w;
+}
+
+/**
+ * FixedMatrix: a Matrix whose dimensions (M x N) are known at compile time.
+ * Columns are FixedVectors stored inline, so FixedMatrices never touch
+ * the heap.
+ */
+template <int M, int N, typename T = float>
+class FixedMatrix
+{
+public:
+    using value_type = T;
+    using column_type = FixedVector<M, T>;
+
+    FixedMatrix()
+    {}
+
+    explicit FixedMatrix(T initVal)
+    {
+        Unroll<N>::apply([&](int j) { _c[j] = column_type(initVal); });
+    }
+
+    explicit FixedMatrix(const BasicMatrix<T>& A)
+    {
+        assert(A.rows() == M && A.cols() == N);
+        Unroll<N>::apply([&](int j) { _c[j] = column_type(A[j]); });
+    }
+
+    FixedMatrix& operator+=(const FixedMatrix& A)
+    {
+        Unroll<N>::apply([&](int j) { _c[j] += A._c[j]; });
+        return *this;
+    }
+
+    FixedMatrix& operator-=(const FixedMatrix& A)
+    {
+        Unroll<N>::apply([&](int j) { _c[j] -= A._c[j]; });
+        return *this;
+    }
+
+    FixedMatrix& operator*=(T f)
+    {
+        Unroll<N>::apply([&](int j) { _c[j] *= f; });
+        return *this;
+    }
+
+    column_type& operator[](int j)  // column accessor
+    {
+        assert(j >= 0 && j < N);
+        return _c[j];
+    }
+
+    const column_type& operator[](int j) const  // column accessor
+    {
+        assert(j >= 0 && j < N);
+        return _c[j];
+    }
+
+    column_type* begin() { return _c; }
+    const column_type* begin() const { return _c; }
+    column_type* end() { return _c + N; }
+    const column_type* end() const { return _c + N; }
+
+    static constexpr int rows() { return M; }
+    static constexpr int cols() { return N; }
+
+    BasicMatrix<T> toMatrix() const
+    {
+        BasicMatrix<T> A(M, N);
+        Unroll<N>::apply([&](int j)
+        {
+            Unroll<M>::apply([&](int i) { A[j][i] = _c[j][i]; });
+        });
+        return A;
+    }
+
+    // Factories:
+    static FixedMatrix fromRows(std::initializer_list<FixedVector<N, T>> rlist)
+    {
+        assert(rlist.size() == M);
+        FixedMatrix A;
+        int i = 0;
+        for (const FixedVector<N, T>& r : rlist)
+        {
+            Unroll<N>::apply([&](int j) { A._c[j][i] = r[j]; });
+            ++i;
+        }
+        return A;
+    }
+
+    static FixedMatrix identity()
+    {
+        static_assert(M == N, "identity matrix must be square");
+        FixedMatrix I(T(0));
+        Unroll<N>::apply([&](int j) { I._c[j][j] = T(1); });
+        return I;
+    }
+
+private:
+    column_type _c[N];
+};
+
+template <int M, int N, typename T>
+bool operator==(const FixedMatrix<M, N, T>& A, const FixedMatrix<M, N, T>& B)
+{
+    bool equal = true;
+    Unroll<N>::apply([&](int j) { equal = equal && A[j] == B[j]; });
+    return equal;
+}
+
+template <int M, int N, typename T>
+bool operator!=(const FixedMatrix<M, N, T>& A, const FixedMatrix<M, N, T>& B)
+{
+    return !(A == B);
+}
+
+template <int M, int N, typename T>
+FixedMatrix<M, N, T> operator+(FixedMatrix<M, N, T> A,
+                               const FixedMatrix<M, N, T>& B)
+{
+    return A += B;
+}
+
+template <int M, int N, typename T>
+FixedMatrix<M, N, T> operator-(FixedMatrix<M, N, T> A,
+                               const FixedMatrix<M, N, T>& B)
+{
+    return A -= B;
+}
+
+template <int M, int N, typename T>
+FixedMatrix<M, N, T> operator*(FixedMatrix<M, N, T> A,
+                               typename FixedMatrix<M, N, T>::value_type f)
+{
+    return A *= f;
+}
+
+template <int M, int N, typename T>
+FixedMatrix<M, N, T> operator*(typename FixedMatrix<M, N, T>::value_type f,
+                               FixedMatrix<M, N, T> A)
+{
+    return A *= f;
+}
+
+template <int M, int N, typename T>
+FixedVector<M, T> operator*(const FixedMatrix<M, N, T>& A,
+                            const FixedVector<N, T>& x)
+{
+    FixedVector<M, T> b(T(0));
+    Unroll<N>::apply([&](int j)
+    {
+        Unroll<M>::apply([&](int i) { b[i] += A[j][i] * x[j]; });
+    });
+    return b;
+}
+
+template <int M, int K, int N, typename T>
+FixedMatrix<M, N, T> operator*(const FixedMatrix<M, K, T>& A,
+                               const FixedMatrix<K, N, T>& B)
+{
+    FixedMatrix<M, N, T> C;
+    Unroll<N>::apply([&](int j) { C[j] = A * B[j]; });
+    return C;
+}
+
+template <int M, int N, typename T>
+std::ostream& operator<<(std::ostream& os, const FixedMatrix<M, N, T>& A)
+{
+    return os << A.toMatrix();
+}
+
+template <int M, int N, typename T>
+bool approxEqual(const FixedMatrix<M, N, T>& A, const FixedMatrix<M, N, T>& B,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon())
+{
+    bool equal = true;
+    Unroll<N>::apply([&](int j)
+    {
+        equal = equal && approxEqual(A[j], B[j], epsilon);
+    });
+    return equal;
+}
+
+template <int M, int N, typename T>
+FixedMatrix<N, M, T> transpose(const FixedMatrix<M, N, T>& A)
+{
+    FixedMatrix<N, M, T> AT;
+    Unroll<N>::apply([&](int j)
+    {
+        Unroll<M>::apply([&](int i) { AT[i][j] = A[j][i]; });
+    });
+    return AT;
+}
+
+}  // namespace la
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "inc/view.h"
+#include <iosfwd>
+
+namespace la
+{
+
+// Room for the shortest round-trip text of any supported scalar.
+const int MAX_SCALAR_CHARS = 64;
+
+/**
+ * FormatOptions: limits on the rows written by print(). When a matrix has
+ * more than head + tail rows, only its first head and last tail rows are
+ * written, separated by a line holding "...". A negative head writes every
+ * row.
+ */
+struct FormatOptions
+{
+    int head = -1;
+    int tail = 0;
+};
+
+template <typename T>
+char* formatScalar(char* first, char* last, T x);
+
+template <typename T>
+void print(std::ostream& os, const BasicConstVectorView<T>& x);
+template <typename T>
+void print(std::ostream& os, const BasicConstMatrixView<T>& A,
+           FormatOptions options = FormatOptions());
+
+}  // namespace la
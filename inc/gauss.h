@@ -4,27 +4,73 @@
 #include "inc/matrix.h"
 #include <set>
 #include <map>
+#include <vector>
 
 namespace la
 {
 
+/**
+ * RowPermutation: row interchanges recorded rather than performed, so each
+ * swap() is O(1) whatever the width of the matrix. permuteRows() then moves
+ * every row to its final place in a single pass down the columns.
+ */
+class RowPermutation
+{
+public:
+    explicit RowPermutation(int m);
+
+    int size() const;
+    int operator[](int i) const;  // row that ends up as row i
+    void swap(int i1, int i2);
+
+private:
+    std::vector<int> _src;  // _src[i] is the row that ends up as row i
+};
+
+// Selects a pivot row of a column among the given rows, or returns -1.
+template <typename T>
+using PivotSelector = int (*)(const BasicVector<T>&, const std::set<int>&);
+
 // Gaussian elimination
-void eliminate(Matrix& A, int (*)(const Vector&, const std::set<int>&));
-void forwardReduce(Matrix& A, int (*)(const Vector&, const std::set<int>&));
-void backwardReduce(Matrix& U);
+template <typename T>
+void eliminate(BasicMatrix<T>& A, PivotSelector<T> pivotSelector);
+template <typename T>
+void forwardReduce(BasicMatrix<T>& A, PivotSelector<T> pivotSelector);
+template <typename T>
+void backwardReduce(BasicMatrix<T>& U);
 
 // LU factorization
-void factor(const Matrix& A, int (*)(const Vector&, const std::set<int>&),
-            Matrix& L, Matrix& U);
-void permute(const Matrix& V, const std::map<int, int>& perm, Matrix& U);
+template <typename T>
+void factor(const BasicMatrix<T>& A, PivotSelector<T> pivotSelector,
+            BasicMatrix<T>& L, BasicMatrix<T>& U);
+template <typename T>
+void permute(const BasicMatrix<T>& V, const std::map<int, int>& perm,
+             BasicMatrix<T>& U);
+
+// Compact LU factorization with partial pivoting
+template <typename T>
+bool luFactor(BasicMatrix<T>& A, std::vector<int>& piv);
+template <typename T>
+void luSolve(const BasicMatrix<T>& LU, const std::vector<int>& piv,
+             BasicVector<T>& b);
 
 // Pivot selectors
-int partialPivotSelector(const Vector& c, const std::set<int>& rows);
-int firstNonzeroPivotSelector(const Vector& c, const std::set<int>& rows);
+template <typename T>
+int partialPivotSelector(const BasicVector<T>& c, const std::set<int>& rows);
+template <typename T>
+int firstNonzeroPivotSelector(const BasicVector<T>& c,
+                              const std::set<int>& rows);
 
 // Elementary row operations
-void swapRows(Matrix& A, int i1, int i2, int lo = 0);
-void scaleRow(Matrix& A, int i, float f, int lo = 0);
-void replaceRow(Matrix& A, int i1, int i2, float f, int lo = 0);
+template <typename T>
+void swapRows(BasicMatrix<T>& A, int i1, int i2, int lo = 0);
+template <typename T>
+void scaleRow(BasicMatrix<T>& A, int i, typename BasicMatrix<T>::value_type f,
+              int lo = 0);
+template <typename T>
+void replaceRow(BasicMatrix<T>& A, int i1, int i2,
+                typename BasicMatrix<T>::value_type f, int lo = 0);
+template <typename T>
+void permuteRows(BasicMatrix<T>& A, const RowPermutation& P);
 
-}  // namespace la
\ No newline at end of file
+}  // namespace la
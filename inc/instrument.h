@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Optional per-operation counters. Build with -DLA_INSTRUMENT to make every
+ * instrumented library function count its calls, floating-point operations,
+ * bytes moved, heap allocations and wall time; otherwise the macros below
+ * expand to nothing. Counts are inclusive: an operation's totals include
+ * those of the operations it calls.
+ */
+#ifdef LA_INSTRUMENT
+#define LA_PROFILE(name, flops, bytes)                                        \
+    static ::la::instrument::Counter& laCounter_ =                            \
+        ::la::instrument::counter(name);                                      \
+    ::la::instrument::Scope laScope_(laCounter_, (flops), (bytes))
+#define LA_ADD_WORK(flops, bytes) ::la::instrument::addWork((flops), (bytes))
+#else
+#define LA_PROFILE(name, flops, bytes) ((void)0)
+#define LA_ADD_WORK(flops, bytes) ((void)0)
+#endif
+
+namespace la
+{
+
+namespace instrument
+{
+
+// Totals for one operation, as returned by snapshot().
+struct OpStats
+{
+    std::string name;
+    std::uint64_t calls;
+    std::uint64_t flops;
+    std::uint64_t bytes;
+    std::uint64_t allocations;
+    double seconds;
+};
+
+bool enabled();
+std::vector<OpStats> snapshot();
+void reset();
+
+// Running totals of one operation; shared by all threads.
+struct Counter
+{
+    const char* name;
+    std::atomic<std::uint64_t> calls;
+    std::atomic<std::uint64_t> flops;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> allocations;
+    std::atomic<std::uint64_t> nanos;
+};
+
+Counter& counter(const char* name);
+void addWork(double flops, double bytes);
+
+/**
+ * Scope: measures one call of an operation, from construction to
+ * destruction, and adds its work to the enclosing Scope on the thread.
+ */
+class Scope
+{
+public:
+    Scope(Counter& c, double flops, double bytes);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    friend void addWork(double flops, double bytes);
+
+    Counter& _c;
+    Scope* _parent;
+    double _flops;
+    double _bytes;
+    std::size_t _allocs;  // heapAllocations() on entry
+    std::chrono::steady_clock::time_point _start;
+};
+
+}  // namespace instrument
+
+}  // namespace la
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "inc/util.h"
+#include "inc/vector.h"
+#include "inc/linop.h"
+#include <vector>
+
+namespace la
+{
+
+/**
+ * ConjugateGradient: preconditioned conjugate gradient solver for symmetric
+ * positive definite systems A x = b. The work vectors are allocated once,
+ * at construction, and reused by every solve of order n.
+ * The optional preconditioner M applies the inverse of an SPD approximation
+ * of A. A solve stops once ||b - A x|| <= tol * ||b|| or after maxIter
+ * iterations (n if maxIter is not positive).
+ */
+class ConjugateGradient
+{
+public:
+    explicit ConjugateGradient(int n, float tol = DEFAULT_EPSILON,
+                               int maxIter = 0);
+
+    bool solve(const LinearOperator& A, const Vector& b, Vector& x,
+               const LinearOperator* M = nullptr);
+
+    int iterations() const;  // iterations taken by the last solve
+    float residual() const;  // relative residual norm after the last solve
+
+private:
+    float _tol;
+    int _maxIter;
+    int _iters;
+    float _res;
+    Vector _r;  // residual
+    Vector _z;  // preconditioned residual
+    Vector _p;  // search direction
+    Vector _q;  // A p
+};
+
+/**
+ * GMRES: restarted generalized minimal residual solver for general square
+ * systems A x = b. The Arnoldi basis is orthogonalized by classical
+ * Gram-Schmidt with one full reorthogonalization pass, and the Hessenberg
+ * least squares problem is reduced by Givens rotations as it grows, so the
+ * residual norm is known at every iteration without forming x.
+ * The optional preconditioner M is applied on the right, so the residual
+ * tested is that of the original system.
+ */
+class GMRES
+{
+public:
+    explicit GMRES(int n, int restart = 30, float tol = DEFAULT_EPSILON,
+                   int maxIter = 0);
+
+    bool solve(const LinearOperator& A, const Vector& b, Vector& x,
+               const LinearOperator* M = nullptr);
+
+    int iterations() const;  // iterations taken by the last solve
+    float residual() const;  // relative residual norm after the last solve
+
+private:
+    float _tol;
+    int _restart;
+    int _maxIter;
+    int _iters;
+    float _res;
+    std::vector<Vector> _v;   // Arnoldi basis, restart + 1 vectors
+    std::vector<float> _h;    // Hessenberg matrix, (restart + 1) x restart
+    std::vector<float> _cs;   // Givens rotation cosines
+    std::vector<float> _sn;   // Givens rotation sines
+    std::vector<float> _g;    // rotated right-hand side
+    std::vector<double> _hj;  // Gram-Schmidt coefficients of one pass
+    Vector _w;                // A M^-1 v
+    Vector _z;                // M^-1 v
+};
+
+/**
+ * BiCGSTAB: stabilized biconjugate gradient solver for general square
+ * systems A x = b, with an optional right preconditioner M. Uses a fixed
+ * amount of storage and two applications of A per iteration.
+ */
+class BiCGSTAB
+{
+public:
+    explicit BiCGSTAB(int n, float tol = DEFAULT_EPSILON, int maxIter = 0);
+
+    bool solve(const LinearOperator& A, const Vector& b, Vector& x,
+               const LinearOperator* M = nullptr);
+
+    int iterations() const;  // iterations taken by the last solve
+    float residual() const;  // relative residual norm after the last solve
+
+private:
+    float _tol;
+    int _maxIter;
+    int _iters;
+    float _res;
+    Vector _r;     // residual
+    Vector _rHat;  // shadow residual
+    Vector _p;     // search direction
+    Vector _v;     // A M^-1 p
+    Vector _s;     // intermediate residual
+    Vector _t;     // A M^-1 s
+    Vector _pHat;  // M^-1 p
+    Vector _sHat;  // M^-1 s
+};
+
+}  // namespace la
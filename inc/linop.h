@@ -0,0 +1,81 @@
+#pragma once
+
+#include "inc/vector.h"
+#include "inc/matrix.h"
+#include "inc/sparse.h"
+#include <functional>
+
+namespace la
+{
+
+/**
+ * LinearOperator: an m x n linear map known only through its action on
+ * vectors. Iterative solvers accept any LinearOperator, so a system can be
+ * solved without its matrix ever being formed.
+ */
+class LinearOperator
+{
+public:
+    virtual ~LinearOperator() {}
+
+    virtual int rows() const = 0;
+    virtual int cols() const = 0;
+
+    // Writes A x to y, which must already have rows() entries.
+    virtual void apply(const Vector& x, Vector& y) const = 0;
+};
+
+/**
+ * DenseOperator: the LinearOperator of a (borrowed) dense Matrix.
+ */
+class DenseOperator : public LinearOperator
+{
+public:
+    explicit DenseOperator(const Matrix& A);
+
+    int rows() const override;
+    int cols() const override;
+    void apply(const Vector& x, Vector& y) const override;
+
+private:
+    const Matrix& _A;
+};
+
+/**
+ * SparseOperator: the LinearOperator of a (borrowed) SparseMatrix.
+ */
+class SparseOperator : public LinearOperator
+{
+public:
+    explicit SparseOperator(const SparseMatrix& A);
+
+    int rows() const override;
+    int cols() const override;
+    void apply(const Vector& x, Vector& y) const override;
+
+private:
+    const SparseMatrix& _A;
+};
+
+/**
+ * CallbackOperator: a LinearOperator whose action is a user-supplied
+ * function writing A x to y.
+ */
+class CallbackOperator : public LinearOperator
+{
+public:
+    using Callback = std::function<void(const Vector&, Vector&)>;
+
+    CallbackOperator(int m, int n, Callback f);
+
+    int rows() const override;
+    int cols() const override;
+    void apply(const Vector& x, Vector& y) const override;
+
+private:
+    int _m;
+    int _n;
+    Callback _f;
+};
+
+}  // namespace la
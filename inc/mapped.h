@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace la
+{
+
+/**
+ * MappedFile: the contents of a file mapped read-only into memory, unmapped
+ * on destruction. The file must not change while it is mapped.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& f);
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& f);
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    void adviseSequential() const;
+
+    const char* begin() const;
+    const char* end() const;
+    std::size_t size() const;
+
+private:
+    const char* _data;  // start of the mapping, or null
+    std::size_t _size;  // length of the mapping in bytes
+};
+
+}  // namespace la
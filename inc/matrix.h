@@ -2,82 +2,147 @@
 
 #include "inc/util.h"
 #include "inc/vector.h"
+#include "inc/view.h"
 #include <initializer_list>
 #include <iostream>
 
 namespace la
 {
 
+// Explicit leading dimension for a BasicMatrix (at least its row count).
+struct LeadingDim
+{
+    int value;
+};
+
 /**
- * Matrix: represents a two-dimensional (m x n) grid of floating-point values.
+ * BasicMatrix: represents a two-dimensional (m x n) grid of scalar values.
+ * Instantiated for the same scalar types as BasicVector.
+ * Entries are stored in one block in column-major order, and each column
+ * Vector refers into that storage. Columns start ld() entries apart; by
+ * default long columns are padded so that each starts on a cache line. A BasicMatrix is a view of its own
+ * entries, so it can be passed wherever a BasicMatrixView is expected.
  */
-class Matrix
+template <typename T>
+class BasicMatrix : public BasicMatrixView<T>
 {
 public:
-    Matrix(int m, int n);
-    Matrix(int m, int n, float initVal);
-    Matrix(const Matrix& A);
-    ~Matrix();
-
-    Matrix& operator=(const Matrix& A);
-    Matrix& operator+=(const Matrix& A);
-    Matrix& operator-=(const Matrix& A);
-    Matrix& operator*=(float f);
-    Vector& operator[](int j);              // column accessor
-    const Vector& operator[](int j) const;  // column accessor
-
-    Vector* begin();
-    const Vector* begin() const;
-    Vector* end();
-    const Vector* end() const;
-
-    int rows() const;
-    int cols() const;
+    using value_type = T;
+    using real_type = RealType<T>;
+    using column_type = BasicVector<T>;
+
+    BasicMatrix(int m, int n);
+    BasicMatrix(int m, int n, LeadingDim ld);
+    BasicMatrix(int m, int n, T initVal);
+    BasicMatrix(const BasicMatrix& A);
+    explicit BasicMatrix(const BasicConstMatrixView<T>& A);
+    ~BasicMatrix();
+
+    BasicMatrix& operator=(const BasicMatrix& A);
+    BasicMatrix& operator+=(const BasicMatrix& A);
+    BasicMatrix& operator-=(const BasicMatrix& A);
+    BasicMatrix& operator*=(T f);
+    BasicVector<T>& operator[](int j);              // column accessor
+    const BasicVector<T>& operator[](int j) const;  // column accessor
+
+    BasicVector<T>* begin();
+    const BasicVector<T>* begin() const;
+    BasicVector<T>* end();
+    const BasicVector<T>* end() const;
+
+    // Views; those of a const matrix are read-only.
+    T& operator()(int i, int j);
+    const T& operator()(int i, int j) const;
+    T* data();
+    const T* data() const;
+    BasicMatrixView<T> block(int i, int j, int m, int n);
+    BasicConstMatrixView<T> block(int i, int j, int m, int n) const;
+    BasicVectorView<T> row(int i);
+    BasicConstVectorView<T> row(int i) const;
+    BasicVectorView<T> col(int j);
+    BasicConstVectorView<T> col(int j) const;
+    BasicVectorView<T> diag();
+    BasicConstVectorView<T> diag() const;
 
     // Factories:
-    static Matrix fromRows(std::initializer_list<Vector> rlist);
-    static Matrix fromCols(std::initializer_list<Vector> clist);
-    static Matrix fromDiag(const Vector& d);
-    static Matrix identity(int n);
-    static Matrix random(int m, int n);
-    static Matrix random(int m, int n, float lo, float hi);
+    static BasicMatrix fromRows(std::initializer_list<BasicVector<T>> rlist);
+    static BasicMatrix fromCols(std::initializer_list<BasicVector<T>> clist);
+    static BasicMatrix fromDiag(const BasicVector<T>& d);
+    static BasicMatrix identity(int n);
+    static BasicMatrix random(int m, int n);
+    static BasicMatrix random(int m, int n, T lo, T hi);
 
 private:
-    int _m;       // number of rows
-    int _n;       // number of columns
-    void* _bp;    // pointer to first byte of first column
-    Vector* _cp;  // pointer to first column
+    using BasicMatrixView<T>::_p;
+    using BasicMatrixView<T>::_m;
+    using BasicMatrixView<T>::_n;
+    using BasicMatrixView<T>::_ld;
+
+    void* _bp;            // pointer to first byte of first column
+    BasicVector<T>* _cp;  // pointer to first column
 };
 
-bool operator==(const Matrix& A, const Matrix& B);
-bool operator!=(const Matrix& A, const Matrix& B);
-Matrix operator+(const Matrix& A, const Matrix& B);
-Matrix operator-(const Matrix& A, const Matrix& B);
-Matrix operator*(const Matrix& A, float f);
-Matrix operator*(float f, const Matrix& A);
-Vector operator*(const Matrix& A, const Vector& x);
-Matrix operator*(const Matrix& A, const Matrix& B);
-std::ostream& operator<<(std::ostream& os, const Matrix& A);
-
-Matrix round(const Matrix& A, float epsilon = DEFAULT_EPSILON);
-bool approxEqual(const Matrix& A, const Matrix& B,
-                 float epsilon = DEFAULT_EPSILON);
-
-Matrix augment(const Matrix& A, const Vector& b);
-Matrix augment(const Matrix& A, const Matrix& B);
-Matrix deleteRow(const Matrix& A, int i);
-Matrix deleteCol(const Matrix& A, int j);
-Matrix deleteRowAndCol(const Matrix& A, int i, int j);
-Matrix partition(const Matrix& A, std::pair<int, int> topLeft,
-                 std::pair<int, int> bottomRight);
-
-bool isSquare(const Matrix& A);
-bool isInvertible(const Matrix& A);
-
-Matrix pow(const Matrix& A, unsigned int k);
-Matrix transpose(const Matrix& A);
-bool inverse(const Matrix& A, Matrix& AInv);
-float det(const Matrix& A);
+using Matrix = BasicMatrix<float>;
 
-}  // namespace la
+template <typename T>
+bool operator==(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+bool operator!=(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+BasicMatrix<T> operator+(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+BasicMatrix<T> operator-(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T>& A,
+                         typename BasicMatrix<T>::value_type f);
+template <typename T>
+BasicMatrix<T> operator*(typename BasicMatrix<T>::value_type f,
+                         const BasicMatrix<T>& A);
+template <typename T>
+BasicVector<T> operator*(const BasicMatrix<T>& A, const BasicVector<T>& x);
+template <typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& A);
+
+template <typename T>
+BasicMatrix<T> round(const BasicMatrix<T>& A,
+                     RealType<T> epsilon = ScalarTraits<T>::epsilon());
+template <typename T>
+bool approxEqual(const BasicMatrix<T>& A, const BasicMatrix<T>& B,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon());
+
+template <typename T>
+BasicMatrix<T> augment(const BasicMatrix<T>& A, const BasicVector<T>& b);
+template <typename T>
+BasicMatrix<T> augment(const BasicMatrix<T>& A, const BasicMatrix<T>& B);
+template <typename T>
+BasicMatrix<T> deleteRow(const BasicMatrix<T>& A, int i);
+template <typename T>
+BasicMatrix<T> deleteCol(const BasicMatrix<T>& A, int j);
+template <typename T>
+BasicMatrix<T> deleteRowAndCol(const BasicMatrix<T>& A, int i, int j);
+template <typename T>
+BasicMatrix<T> partition(const BasicMatrix<T>& A, std::pair<int, int> topLeft,
+                         std::pair<int, int> bottomRight);
 
+template <typename T>
+bool isSquare(const BasicMatrix<T>& A);
+template <typename T>
+bool isInvertible(const BasicMatrix<T>& A);
+
+template <typename T>
+BasicMatrix<T> pow(const BasicMatrix<T>& A, unsigned int k);
+template <typename T>
+BasicMatrix<T> transpose(const BasicMatrix<T>& A);
+template <typename T>
+void transpose(const BasicConstMatrixView<T>& A, const BasicMatrixView<T>& AT,
+               int threads = 1);
+template <typename T>
+void transposeInPlace(const BasicMatrixView<T>& A);
+template <typename T>
+bool inverse(const BasicMatrix<T>& A, BasicMatrix<T>& AInv);
+template <typename T>
+T det(const BasicMatrix<T>& A);
+
+}  // namespace la
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "inc/sparse.h"
+#include "inc/view.h"
+#include <string>
+
+namespace la
+{
+
+enum class MatrixMarketField { Real, Integer, Complex, Pattern };
+enum class MatrixMarketSymmetry
+{
+    General,
+    Symmetric,
+    SkewSymmetric,
+    Hermitian
+};
+
+/**
+ * MatrixMarketHeader: the banner and size line of a Matrix Market file.
+ * Symmetric, skew-symmetric and Hermitian files store only the lower
+ * triangle; readers fill in the rest.
+ */
+struct MatrixMarketHeader
+{
+    bool coordinate;  // coordinate (sparse) rather than array (dense) format
+    MatrixMarketField field;
+    MatrixMarketSymmetry symmetry;
+    int rows;
+    int cols;
+    long long entries;  // entry lines that follow the size line
+};
+
+bool readMatrixMarketHeader(const std::string& path, MatrixMarketHeader& h);
+template <typename T>
+bool readMatrixMarket(const std::string& path, const BasicMatrixView<T>& A,
+                      int threads = 0);
+bool readMatrixMarket(const std::string& path, SparseMatrix& A,
+                      int threads = 0);
+
+template <typename T>
+bool writeMatrixMarket(const std::string& path,
+                       const BasicConstMatrixView<T>& A);
+bool writeMatrixMarket(const std::string& path, const SparseMatrix& A);
+
+}  // namespace la
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "inc/binary.h"
+#include "inc/mapped.h"
+#include "inc/view.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace la
+{
+
+/**
+ * NpyHeader: the array description at the start of a NumPy .npy file.
+ * One-dimensional arrays are read as columns and zero-dimensional arrays
+ * as 1 x 1 matrices. Only little-endian float32, float64, complex64 and
+ * complex128 arrays are supported.
+ */
+struct NpyHeader
+{
+    BinaryType dtype;
+    bool fortranOrder;       // column-major rather than row-major entries
+    int rows;
+    int cols;
+    std::size_t dataOffset;  // bytes from the start of the file to entry 0
+};
+
+bool parseNpyHeader(const char* data, std::size_t size, NpyHeader& h);
+bool readNpyHeader(const std::string& path, NpyHeader& h);
+template <typename T>
+bool readNpy(const std::string& path, const BasicMatrixView<T>& A);
+template <typename T>
+bool writeNpy(const std::string& path, const BasicConstMatrixView<T>& A);
+
+/**
+ * NpzReader: the arrays of a NumPy .npz archive, as written by numpy.savez.
+ * Arrays are named without the ".npy" suffix of their archive entries.
+ * Compressed entries (numpy.savez_compressed) cannot be read.
+ */
+class NpzReader
+{
+public:
+    bool open(const std::string& path);
+    void close();
+    const std::vector<std::string>& names() const;
+    bool header(const std::string& name, NpyHeader& h) const;
+    template <typename T>
+    bool read(const std::string& name, const BasicMatrixView<T>& A) const;
+
+private:
+    struct Entry
+    {
+        std::size_t offset;  // start of the .npy data in the archive
+        std::size_t size;    // length of the .npy data
+        std::uint32_t crc;   // CRC-32 of the .npy data
+        bool stored;         // false if compressed
+    };
+
+    const Entry* find(const std::string& name) const;
+
+    MappedFile _file;
+    std::vector<std::string> _names;
+    std::vector<Entry> _entries;
+};
+
+template <typename T>
+bool writeNpz(const std::string& path, const std::vector<std::string>& names,
+              const std::vector<BasicConstMatrixView<T>>& arrays);
+
+}  // namespace la
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "inc/view.h"
+#include <atomic>
+#include <cstddef>
+
+namespace la
+{
+
+/**
+ * BasicVectorPool: a growing collection of vectors of one length, stored
+ * contiguously as the columns of a matrix. The pool reserves address
+ * space for capacity() vectors up front and the system commits memory
+ * only as vectors are added, so the entries never move: views stay valid
+ * and any number of threads can append at once without locks. view()
+ * is the pool as a matrix, so collected vectors can feed gemm() and other
+ * kernels directly. Vectors appended by other threads are safe to read
+ * once those threads have been joined or otherwise synchronized with.
+ */
+template <typename T>
+class BasicVectorPool
+{
+public:
+    BasicVectorPool(int length, int capacity);
+    BasicVectorPool(const BasicVectorPool&) = delete;
+    ~BasicVectorPool();
+
+    BasicVectorPool& operator=(const BasicVectorPool&) = delete;
+
+    int append(const BasicConstVectorView<T>& v);
+    int claim(int count = 1);
+    void clear();
+
+    BasicVectorView<T> operator[](int i) const;
+    BasicMatrixView<T> view() const;
+
+    int length() const;
+    int size() const;
+    int capacity() const;
+
+private:
+    T* _p;                    // start of the reserved address space
+    int _length;              // entries in each vector
+    int _ld;                  // distance between consecutive vectors
+    int _capacity;            // vectors the reservation can hold
+    std::size_t _bytes;       // length of the reservation
+    std::atomic<int> _count;  // vectors claimed so far
+};
+
+using VectorPool = BasicVectorPool<float>;
+
+}  // namespace la
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "inc/vector.h"
+#include "inc/matrix.h"
+#include "inc/sparse.h"
+#include "inc/linop.h"
+#include <vector>
+
+namespace la
+{
+
+/**
+ * JacobiPreconditioner: applies the inverse of the diagonal of A.
+ * Zero diagonal entries are treated as ones.
+ */
+class JacobiPreconditioner : public LinearOperator
+{
+public:
+    explicit JacobiPreconditioner(const Matrix& A);
+    explicit JacobiPreconditioner(const SparseMatrix& A);
+
+    int rows() const override;
+    int cols() const override;
+    void apply(const Vector& r, Vector& z) const override;
+
+private:
+    Vector _invDiag;
+};
+
+/**
+ * ILU0Preconditioner: applies the inverse of L U, where L (unit lower) and
+ * U (upper) are the incomplete LU factors of A restricted to A's own
+ * sparsity pattern. The factors are stored by rows.
+ */
+class ILU0Preconditioner : public LinearOperator
+{
+public:
+    explicit ILU0Preconditioner(const SparseMatrix& A);
+
+    bool valid() const;  // false if a zero pivot was met during factoring
+
+    int rows() const override;
+    int cols() const override;
+    void apply(const Vector& r, Vector& z) const override;
+
+private:
+    int _n;
+    bool _valid;
+    std::vector<int> _rp;     // row pointers
+    std::vector<int> _ci;     // column indices, increasing within each row
+    std::vector<float> _lu;   // L (strictly lower) and U (upper) values
+    std::vector<int> _diag;   // position of each row's diagonal entry
+};
+
+}  // namespace la
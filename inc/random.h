@@ -0,0 +1,65 @@
+#pragma once
+
+#include "inc/util.h"
+#include "inc/view.h"
+#include <array>
+#include <complex>
+#include <cstdint>
+
+namespace la
+{
+
+/**
+ * Philox: the Philox4x32-10 counter-based random number generator of
+ * Salmon et al. Each 128-bit counter maps to 128 random bits under the
+ * key given by the seed, with no state in between, so any part of a
+ * random sequence can be generated independently and from any thread.
+ */
+class Philox
+{
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+    explicit Philox(std::uint64_t seed);
+
+    Block operator()(const Block& counter) const;
+
+private:
+    std::uint32_t _key[2];
+};
+
+std::uint64_t randomSeed();
+
+// Upper corner of the region random() samples from by default.
+template <typename T>
+T unitCorner(T)
+{
+    return 1;
+}
+
+template <typename T>
+std::complex<T> unitCorner(std::complex<T>)
+{
+    return {1, 1};
+}
+
+/**
+ * Random matrix generation. Entry (i, j) of A is drawn from counter
+ * (i0 + i, j0 + j) of the generator seeded with seed, so A may be a block
+ * at (i0, j0) of a larger random matrix, and generating the blocks
+ * separately, or with any number of threads, gives the same entries as
+ * generating the whole. Complex entries have independent real and
+ * imaginary parts. threads <= 0 uses every hardware thread.
+ */
+template <typename T>
+void fillUniform(const BasicMatrixView<T>& A, std::uint64_t seed,
+                 typename BasicMatrixView<T>::value_type lo,
+                 typename BasicMatrixView<T>::value_type hi,
+                 int i0 = 0, int j0 = 0, int threads = 1);
+template <typename T>
+void fillNormal(const BasicMatrixView<T>& A, std::uint64_t seed,
+                typename BasicMatrixView<T>::value_type mean = T(0),
+                RealType<T> stddev = 1, int i0 = 0, int j0 = 0,
+                int threads = 1);
+
+}  // namespace la
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "inc/vector.h"
+#include "inc/matrix.h"
+#include <memory>
+#include <vector>
+
+namespace la
+{
+
+/**
+ * MixedPrecisionSolver: solves A x = b to double accuracy by iterative
+ * refinement. A is factored once in single precision; each refinement step
+ * computes the residual b - A x in double precision and corrects x using
+ * the single-precision factors. If refinement stagnates or fails to
+ * converge, the solver falls back to a double-precision factorization of A,
+ * computed on first need and kept for later solves.
+ */
+class MixedPrecisionSolver
+{
+public:
+    explicit MixedPrecisionSolver(const BasicMatrix<double>& A,
+                                  int maxIter = 30);
+
+    bool solve(const BasicVector<double>& b, BasicVector<double>& x);
+
+    int iterations() const;     // refinement steps taken by the last solve
+    bool usedFallback() const;  // true if the last solve fell back
+
+private:
+    void residual(const BasicVector<double>& b, const BasicVector<double>& x,
+                  BasicVector<double>& r) const;
+    bool solveDouble(const BasicVector<double>& b, BasicVector<double>& x);
+
+    const BasicMatrix<double>& _A;
+    int _n;
+    int _maxIter;
+    int _iters;
+    bool _fellBack;
+    bool _singleOk;   // false if A is singular in single precision
+    bool _doubleOk;   // false if A is singular in double precision
+    double _normA;    // infinity norm of A
+    Matrix _lu;              // single-precision LU factors of A
+    std::vector<int> _piv;   // single-precision pivots
+    std::unique_ptr<BasicMatrix<double>> _luD;  // double-precision factors
+    std::vector<int> _pivD;                     // double-precision pivots
+};
+
+}  // namespace la
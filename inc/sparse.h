@@ -0,0 +1,50 @@
+#pragma once
+
+#include "inc/vector.h"
+#include "inc/matrix.h"
+#include <vector>
+
+namespace la
+{
+
+/**
+ * SparseMatrix: represents an m x n matrix in compressed sparse column (CSC)
+ * form. Column j's entries occupy positions colPtr()[j] up to colPtr()[j + 1]
+ * of rowIdx() and values(), with row indices in increasing order.
+ */
+class SparseMatrix
+{
+public:
+    SparseMatrix(int m, int n);
+
+    int rows() const;
+    int cols() const;
+    int nonzeros() const;
+
+    const std::vector<int>& colPtr() const;
+    const std::vector<int>& rowIdx() const;
+    const std::vector<float>& values() const;
+
+    float at(int i, int j) const;  // zero if not stored
+
+    // Factories:
+    static SparseMatrix fromTriplets(int m, int n,
+                                     const std::vector<int>& rows,
+                                     const std::vector<int>& cols,
+                                     const std::vector<float>& vals);
+    static SparseMatrix fromDense(const Matrix& A, float dropTol = 0.0F);
+    static SparseMatrix identity(int n);
+
+private:
+    int _m;                   // number of rows
+    int _n;                   // number of columns
+    std::vector<int> _cp;     // column pointers (n + 1)
+    std::vector<int> _ri;     // row index of each stored entry
+    std::vector<float> _vals; // value of each stored entry
+};
+
+Vector operator*(const SparseMatrix& A, const Vector& x);
+Matrix toDense(const SparseMatrix& A);
+SparseMatrix transpose(const SparseMatrix& A);
+
+}  // namespace la
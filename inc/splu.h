@@ -0,0 +1,48 @@
+#pragma once
+
+#include "inc/vector.h"
+#include "inc/sparse.h"
+#include <vector>
+
+namespace la
+{
+
+// Fill-reducing ordering
+std::vector<int> minimumDegreeOrder(const SparseMatrix& A);
+
+/**
+ * SparseLU: LU factorization of a square sparse matrix, P A Q = L U.
+ * Symbolic analysis (the fill-reducing column ordering Q) is separate from
+ * numeric factorization, so matrices sharing a sparsity pattern can be
+ * refactored without repeating it. Rows are chosen by threshold partial
+ * pivoting: the diagonal entry is kept as pivot whenever its magnitude is
+ * at least pivotThreshold times the largest candidate in its column.
+ */
+class SparseLU
+{
+public:
+    explicit SparseLU(float pivotThreshold = 0.1F);
+
+    void analyze(const SparseMatrix& A);
+    bool factor(const SparseMatrix& A);
+    bool solve(const Vector& b, Vector& x) const;
+
+    int size() const;
+    int nonzerosL() const;
+    int nonzerosU() const;
+
+private:
+    float _tol;              // pivot threshold in (0, 1]
+    int _n;                  // order of the factored matrix
+    bool _factored;          // true once factor() has succeeded
+    std::vector<int> _q;     // column k of L U is column _q[k] of A
+    std::vector<int> _p;     // row k of L U is row _p[k] of A
+    std::vector<int> _lp;    // L column pointers; unit diagonal stored first
+    std::vector<int> _li;    // L row indices (in the row numbering of A)
+    std::vector<float> _lx;  // L values
+    std::vector<int> _up;    // U column pointers; diagonal stored last
+    std::vector<int> _ui;    // U row indices (in pivot order)
+    std::vector<float> _ux;  // U values
+};
+
+}  // namespace la
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "inc/binary.h"
+#include "inc/vector.h"
+#include "inc/view.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace la
+{
+
+/**
+ * Tiled matrix files hold a 64-byte TiledHeader followed by the tiles in
+ * column-major order of tiles. Every tile occupies tile x tile entries,
+ * stored column-major, with the tiles on the bottom and right edges
+ * padded, so tile (I, J) starts at a fixed offset.
+ */
+struct TiledHeader
+{
+    char magic[8];            // "LATILED\0"
+    std::uint32_t version;    // TILED_VERSION
+    std::uint32_t dtype;      // BinaryType of the entries
+    std::int64_t rows;
+    std::int64_t cols;
+    std::int64_t tile;        // order of the square tiles
+    std::uint64_t dataOffset;
+    std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(TiledHeader) == 64, "tiled header must be 64 bytes");
+
+const std::uint32_t TILED_VERSION = 1;
+
+/**
+ * BasicTiledMatrix: a matrix kept on disk and paged in a tile at a time
+ * through a cache of a fixed number of tiles, evicting the least recently
+ * used. A tile is used through the view acquire() returns, which stays
+ * valid until the matching release(). Tiles acquired for writing are
+ * written back when evicted, by flush(), or on close. I/O errors are
+ * sticky: once one occurs, failed() is true and flush() returns false.
+ */
+template <typename T>
+class BasicTiledMatrix
+{
+public:
+    BasicTiledMatrix();
+    BasicTiledMatrix(const BasicTiledMatrix&) = delete;
+    ~BasicTiledMatrix();
+
+    BasicTiledMatrix& operator=(const BasicTiledMatrix&) = delete;
+
+    bool create(const std::string& path, int rows, int cols, int tile,
+                int cacheTiles = 16);
+    bool open(const std::string& path, int cacheTiles = 16);
+    bool close();
+    bool isOpen() const;
+
+    int rows() const;
+    int cols() const;
+    int tileSize() const;
+    int tileRows() const;
+    int tileCols() const;
+
+    BasicMatrixView<T> acquire(int I, int J, bool write = false);
+    void release(int I, int J);
+    void prefetch(int I, int J) const;
+    bool flush();
+    bool failed() const;
+
+    bool read(const BasicMatrixView<T>& A);
+    bool write(const BasicConstMatrixView<T>& A);
+
+    long long tileReads() const;
+    long long tileWrites() const;
+
+private:
+    struct Slot
+    {
+        int tile;                  // index of the cached tile, or -1
+        int pins;                  // acquire() calls not yet released
+        bool dirty;                // true if it must be written back
+        unsigned long long used;   // time of the last acquire()
+    };
+
+    int index(int I, int J) const;
+    std::uint64_t offset(int tile) const;
+    T* entries(int slot);
+    bool readTile(int slot);
+    bool writeTile(int slot);
+
+    int _fd;                                // file descriptor, or -1
+    int _m;                                 // number of rows
+    int _n;                                 // number of columns
+    int _t;                                 // order of the tiles
+    std::vector<T> _cache;                  // entries of the cached tiles
+    std::vector<Slot> _slots;               // one per cached tile
+    std::unordered_map<int, int> _where;    // slot of each cached tile
+    unsigned long long _clock;              // acquire() calls so far
+    long long _reads;                       // tiles read from the file
+    long long _writes;                      // tiles written to the file
+    bool _failed;                           // true after an I/O error
+};
+
+using TiledMatrix = BasicTiledMatrix<float>;
+
+// Out-of-core algorithms on tiled matrices of equal tile size
+template <typename T>
+bool gemm(typename BasicMatrixView<T>::value_type alpha,
+          BasicTiledMatrix<T>& A, BasicTiledMatrix<T>& B,
+          typename BasicMatrixView<T>::value_type beta,
+          BasicTiledMatrix<T>& C);
+template <typename T>
+bool luFactor(BasicTiledMatrix<T>& A, std::vector<int>& piv,
+              const std::string& checkpoint = "", int maxPanels = -1);
+template <typename T>
+bool luSolve(BasicTiledMatrix<T>& LU, const std::vector<int>& piv,
+             BasicVector<T>& b);
+
+}  // namespace la
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace la
+{
+
+namespace trace
+{
+
+enum class EventType : std::uint8_t
+{
+    Swap = 1,     // rows row1 and row2 exchanged from column col on
+    Scale = 2,    // row1 scaled by value from column col on
+    Replace = 3,  // row1 += value * row2 from column col on
+    Pivot = 4     // row1 chosen as pivot of column col; value is the pivot
+};
+
+/**
+ * Event: one traced row operation, as stored in the ring buffer and in
+ * trace files. seq numbers events from 1 in the order they were recorded.
+ */
+struct Event
+{
+    std::uint64_t seq;
+    EventType type;
+    std::uint8_t reserved[3];
+    std::int32_t row1;
+    std::int32_t row2;  // -1 if the operation has one row
+    std::int32_t col;
+    double re;          // real part of the factor or pivot
+    double im;          // imaginary part, zero for real matrices
+};
+
+static_assert(sizeof(Event) == 40, "trace files assume 40-byte events");
+
+void start(std::size_t capacity = 1 << 16);
+void stop();
+std::vector<Event> events();
+std::uint64_t dropped();
+
+bool save(const std::string& path);
+bool load(const std::string& path, std::vector<Event>& events,
+          std::uint64_t& dropped);
+
+namespace detail
+{
+extern std::atomic<bool> active;
+void append(EventType type, int row1, int row2, int col, double re,
+            double im);
+}  // namespace detail
+
+/**
+ * Records a row operation if tracing is on. When it is off, the cost is a
+ * single relaxed load.
+ */
+template <typename T>
+inline void record(EventType type, int row1, int row2, int col,
+                   const T& value)
+{
+    if (detail::active.load(std::memory_order_relaxed))
+    {
+        detail::append(type, row1, row2, col,
+                       static_cast<double>(std::real(value)),
+                       static_cast<double>(std::imag(value)));
+    }
+}
+
+}  // namespace trace
+
+}  // namespace la
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "inc/fixed.h"
+
+namespace la
+{
+
+/**
+ * PointsSoA: a borrowed structure-of-arrays buffer of n points in 3-space,
+ * the ith point being (x[i], y[i], z[i]).
+ */
+struct PointsSoA
+{
+    float* x;
+    float* y;
+    float* z;
+    int n;
+};
+
+// Batched point transforms; out may alias in
+void transformPoints(const FixedMatrix<4, 4>& M, const PointsSoA& in,
+                     const PointsSoA& out, int threads = 1);
+void transformPoints(const FixedMatrix<3, 4>& M, const PointsSoA& in,
+                     const PointsSoA& out, int threads = 1);
+
+}  // namespace la
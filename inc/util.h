@@ -1,10 +1,125 @@
 #pragma once
 
+#include <cmath>  // abs(), isnan()
+#include <complex>
+#include <cstdint>
+#include <cstring>  // memcpy()
+#include <limits>
+
 namespace la
 {
 
 constexpr float DEFAULT_EPSILON = 1e-5F;
 
-bool approxEqual(float x, float y, float epsilon = DEFAULT_EPSILON);
+/**
+ * ScalarTraits: properties of the scalar types that vectors and matrices
+ * may hold (float, double, std::complex<float> and std::complex<double>).
+ * Real is the type of magnitudes and tolerances; epsilon() is the default
+ * tolerance of approximate comparisons.
+ */
+template <typename T>
+struct ScalarTraits
+{
+    using Real = T;
+    static constexpr Real epsilon() { return DEFAULT_EPSILON; }
+};
+
+template <>
+struct ScalarTraits<double>
+{
+    using Real = double;
+    static constexpr Real epsilon() { return 1e-12; }
+};
+
+template <typename T>
+struct ScalarTraits<std::complex<T>>
+{
+    using Real = T;
+    static constexpr Real epsilon() { return ScalarTraits<T>::epsilon(); }
+};
+
+template <typename T>
+using RealType = typename ScalarTraits<T>::Real;
+
+namespace detail
+{
+
+template <typename T>
+inline bool approxEqual(T x, T y, RealType<T> epsilon)
+{
+    using std::abs;
+    return abs(x - y) < (abs(x) + abs(y) + 1) * epsilon;
+}
+
+template <typename R, typename Bits>
+inline std::uint64_t ulpDistance(R x, R y)
+{
+    if (std::isnan(x) || std::isnan(y))
+    {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    // Map sign-magnitude bits onto a two's complement number line.
+    Bits a, b;
+    std::memcpy(&a, &x, sizeof(a));
+    std::memcpy(&b, &y, sizeof(b));
+    const Bits lowest = std::numeric_limits<Bits>::min();
+    std::int64_t ka = (a < 0) ? std::int64_t(lowest) - a : a;
+    std::int64_t kb = (b < 0) ? std::int64_t(lowest) - b : b;
+    return (ka > kb) ? std::uint64_t(ka) - std::uint64_t(kb)
+                     : std::uint64_t(kb) - std::uint64_t(ka);
+}
+
+}  // namespace detail
+
+/**
+ * Returns true if x and y differ by less than epsilon relative to their
+ * magnitudes, or absolutely when both are smaller than 1. Defined inline
+ * so comparison loops over many entries do not make a call per entry.
+ */
+inline bool approxEqual(float x, float y, float epsilon = DEFAULT_EPSILON)
+{
+    return detail::approxEqual(x, y, epsilon);
+}
+
+inline bool approxEqual(double x, double y,
+                        double epsilon = ScalarTraits<double>::epsilon())
+{
+    return detail::approxEqual(x, y, epsilon);
+}
+
+inline bool approxEqual(std::complex<float> x, std::complex<float> y,
+                        float epsilon = DEFAULT_EPSILON)
+{
+    return detail::approxEqual(x, y, epsilon);
+}
+
+inline bool approxEqual(std::complex<double> x, std::complex<double> y,
+                        double epsilon = ScalarTraits<double>::epsilon())
+{
+    return detail::approxEqual(x, y, epsilon);
+}
+
+/**
+ * Returns the number of representable values between x and y, counting
+ * +0 and -0 as equal, or the largest std::uint64_t if either is NaN.
+ * Complex values are as far apart as their farthest parts.
+ */
+inline std::uint64_t ulpDistance(float x, float y)
+{
+    return detail::ulpDistance<float, std::int32_t>(x, y);
+}
+
+inline std::uint64_t ulpDistance(double x, double y)
+{
+    return detail::ulpDistance<double, std::int64_t>(x, y);
+}
+
+template <typename R>
+inline std::uint64_t ulpDistance(std::complex<R> x, std::complex<R> y)
+{
+    std::uint64_t re = ulpDistance(x.real(), y.real());
+    std::uint64_t im = ulpDistance(x.imag(), y.imag());
+    return (re > im) ? re : im;
+}
 
 }  // namespace la
@@ -1,61 +1,105 @@
 #pragma once
 
 #include "inc/util.h"
+#include "inc/view.h"
 #include <initializer_list>
 #include <iostream>
 
 namespace la
 {
 
+template <typename T>
+class BasicMatrix;
+
 /**
- * Vector: represents a one-dimensional sequence of floating-point values.
+ * BasicVector: represents a one-dimensional sequence of scalar values.
+ * Instantiated for float, double, std::complex<float>
+ * and std::complex<double>.
+ * A BasicVector is a contiguous view of its own entries, so it can be passed
+ * wherever a BasicVectorView is expected. Vectors of up to inlineCapacity()
+ * entries store them inside the object rather than allocating.
  */
-class Vector
+template <typename T>
+class BasicVector : public BasicVectorView<T>
 {
 public:
-    explicit Vector(int n);
-    Vector(int n, float initVal);
-    Vector(std::initializer_list<float> list);
-    Vector(const Vector& v);
-    ~Vector();
-
-    Vector& operator=(const Vector& v);
-    Vector& operator+=(const Vector& v);
-    Vector& operator-=(const Vector& v);
-    Vector& operator*=(float x);
-    float& operator[](int i);
-    const float& operator[](int i) const;
-
-    float* begin();
-    const float* begin() const;
-    float* end();
-    const float* end() const;
-
-    int size() const;
+    using value_type = T;
+    using real_type = RealType<T>;
+
+    explicit BasicVector(int n);
+    BasicVector(int n, T initVal);
+    BasicVector(std::initializer_list<T> list);
+    BasicVector(const BasicVector& v);
+    explicit BasicVector(const BasicConstVectorView<T>& v);
+    ~BasicVector();
+
+    BasicVector& operator=(const BasicVector& v);
+    BasicVector& operator+=(const BasicVector& v);
+    BasicVector& operator-=(const BasicVector& v);
+    BasicVector& operator*=(T x);
+    T& operator[](int i);
+    const T& operator[](int i) const;
+
+    T* begin();
+    const T* begin() const;
+    T* end();
+    const T* end() const;
+
+    static constexpr int inlineCapacity()
+    {
+        return INLINE_BYTES / sizeof(T);
+    }
 
     // Factories:
-    static Vector random(int n);
-    static Vector random(int n, float lo, float hi);
+    static BasicVector random(int n);
+    static BasicVector random(int n, T lo, T hi);
 
 private:
-    int _n;      // number of entries
-    float* _ep;  // pointer to first entry
+    static const int INLINE_BYTES = 32;
+
+    friend class BasicMatrix<T>;
+
+    // Borrows n entries at p, which the vector will not free.
+    BasicVector(T* p, int n, bool owns);
+
+    using BasicVectorView<T>::_p;
+    using BasicVectorView<T>::_n;
+
+    bool isInline() const;
+
+    bool _owns;  // true if the vector allocated its entries
+    alignas(T) unsigned char _buf[INLINE_BYTES];  // inline entries, if few
 };
 
-bool operator==(const Vector& v, const Vector& w);
-bool operator!=(const Vector& v, const Vector& w);
-Vector operator+(const Vector& v, const Vector& w);
-Vector operator-(const Vector& v, const Vector& w);
-Vector operator*(const Vector& v, float x);
-Vector operator*(float x, const Vector& v);
-std::ostream& operator<<(std::ostream& os, const Vector& v);
+using Vector = BasicVector<float>;
 
-Vector round(const Vector& v, float epsilon = DEFAULT_EPSILON);
-bool approxEqual(const Vector& v, const Vector& w,
-                 float epsilon = DEFAULT_EPSILON);
+template <typename T>
+bool operator==(const BasicVector<T>& v, const BasicVector<T>& w);
+template <typename T>
+bool operator!=(const BasicVector<T>& v, const BasicVector<T>& w);
+template <typename T>
+BasicVector<T> operator+(const BasicVector<T>& v, const BasicVector<T>& w);
+template <typename T>
+BasicVector<T> operator-(const BasicVector<T>& v, const BasicVector<T>& w);
+template <typename T>
+BasicVector<T> operator*(const BasicVector<T>& v,
+                         typename BasicVector<T>::value_type x);
+template <typename T>
+BasicVector<T> operator*(typename BasicVector<T>::value_type x,
+                         const BasicVector<T>& v);
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicVector<T>& v);
 
-Vector homogenize(const Vector& v);
-Vector dehomogenize(const Vector& v);
+template <typename T>
+BasicVector<T> round(const BasicVector<T>& v,
+                     RealType<T> epsilon = ScalarTraits<T>::epsilon());
+template <typename T>
+bool approxEqual(const BasicVector<T>& v, const BasicVector<T>& w,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon());
 
-}  // namespace la
+template <typename T>
+BasicVector<T> homogenize(const BasicVector<T>& v);
+template <typename T>
+BasicVector<T> dehomogenize(const BasicVector<T>& v);
 
+}  // namespace la
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "inc/util.h"
+
+namespace la
+{
+
+/**
+ * BasicConstVectorView: a non-owning, read-only view of n scalars spaced
+ * stride() apart in memory, such as a row, column or diagonal of a matrix.
+ * Copying a view copies the reference, not the entries.
+ */
+template <typename T>
+class BasicConstVectorView
+{
+public:
+    using value_type = T;
+
+    BasicConstVectorView(const T* p, int n, int inc = 1);
+
+    const T& operator[](int i) const;
+
+    const T* data() const;
+    int size() const;
+    int stride() const;
+
+protected:
+    T* _p;     // pointer to first entry
+    int _n;    // number of entries
+    int _inc;  // distance between consecutive entries
+};
+
+/**
+ * BasicVectorView: a non-owning, writable view of n scalars spaced stride()
+ * apart in memory. Like a pointer, a view's constness does not extend to
+ * the entries it refers to.
+ */
+template <typename T>
+class BasicVectorView : public BasicConstVectorView<T>
+{
+public:
+    BasicVectorView(T* p, int n, int inc = 1);
+
+    T& operator[](int i) const;
+
+    T* data() const;
+};
+
+/**
+ * BasicConstMatrixView: a non-owning, read-only view of an m x n matrix
+ * stored in column-major order, with column j starting ld() entries
+ * after column j - 1.
+ */
+template <typename T>
+class BasicConstMatrixView
+{
+public:
+    using value_type = T;
+
+    BasicConstMatrixView(const T* p, int m, int n, int ld);
+
+    const T& operator()(int i, int j) const;
+
+    const T* data() const;
+    int rows() const;
+    int cols() const;
+    int ld() const;
+
+    BasicConstMatrixView block(int i, int j, int m, int n) const;
+    BasicConstVectorView<T> row(int i) const;
+    BasicConstVectorView<T> col(int j) const;
+    BasicConstVectorView<T> diag() const;
+
+protected:
+    T* _p;    // pointer to entry (0, 0)
+    int _m;   // number of rows
+    int _n;   // number of columns
+    int _ld;  // leading dimension: distance between consecutive columns
+};
+
+/**
+ * BasicMatrixView: a non-owning, writable view of a column-major m x n
+ * matrix. Like a pointer, a view's constness does not extend to the
+ * entries it refers to.
+ */
+template <typename T>
+class BasicMatrixView : public BasicConstMatrixView<T>
+{
+public:
+    BasicMatrixView(T* p, int m, int n, int ld);
+
+    T& operator()(int i, int j) const;
+
+    T* data() const;
+
+    BasicMatrixView block(int i, int j, int m, int n) const;
+    BasicVectorView<T> row(int i) const;
+    BasicVectorView<T> col(int j) const;
+    BasicVectorView<T> diag() const;
+};
+
+using ConstVectorView = BasicConstVectorView<float>;
+using VectorView = BasicVectorView<float>;
+using ConstMatrixView = BasicConstMatrixView<float>;
+using MatrixView = BasicMatrixView<float>;
+
+// Orientation in which gemm() reads an operand.
+enum class Op
+{
+    NoTrans,  // the operand as stored
+    Trans     // its transpose
+};
+
+// Kernels on views; BasicVector and BasicMatrix are views of themselves.
+template <typename T>
+void copy(const BasicConstVectorView<T>& x, const BasicVectorView<T>& y);
+template <typename T>
+void copy(const BasicConstMatrixView<T>& A, const BasicMatrixView<T>& B);
+template <typename T>
+void fill(const BasicVectorView<T>& x,
+          typename BasicVectorView<T>::value_type value);
+template <typename T>
+void fill(const BasicMatrixView<T>& A,
+          typename BasicMatrixView<T>::value_type value);
+template <typename T>
+void scale(typename BasicVectorView<T>::value_type alpha,
+           const BasicVectorView<T>& x);
+template <typename T>
+void scale(typename BasicMatrixView<T>::value_type alpha,
+           const BasicMatrixView<T>& A);
+template <typename T>
+void axpy(typename BasicVectorView<T>::value_type alpha,
+          const BasicConstVectorView<T>& x, const BasicVectorView<T>& y);
+template <typename T>
+T dot(const BasicConstVectorView<T>& x, const BasicConstVectorView<T>& y);
+template <typename T>
+void gemv(typename BasicVectorView<T>::value_type alpha,
+          const BasicConstMatrixView<T>& A, const BasicConstVectorView<T>& x,
+          typename BasicVectorView<T>::value_type beta,
+          const BasicVectorView<T>& y);
+template <typename T>
+void gemm(Op opA, Op opB, typename BasicMatrixView<T>::value_type alpha,
+          const BasicConstMatrixView<T>& A, const BasicConstMatrixView<T>& B,
+          typename BasicMatrixView<T>::value_type beta,
+          const BasicMatrixView<T>& C);
+
+template <typename T>
+bool approxEqual(const BasicConstVectorView<T>& x,
+                 const BasicConstVectorView<T>& y,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon());
+template <typename T>
+bool approxEqual(const BasicConstMatrixView<T>& A,
+                 const BasicConstMatrixView<T>& B,
+                 RealType<T> epsilon = ScalarTraits<T>::epsilon());
+template <typename T>
+bool approxEqualUlps(const BasicConstVectorView<T>& x,
+                     const BasicConstVectorView<T>& y, std::uint64_t maxUlps);
+template <typename T>
+bool approxEqualUlps(const BasicConstMatrixView<T>& A,
+                     const BasicConstMatrixView<T>& B, std::uint64_t maxUlps);
+template <typename T>
+RealType<T> maxError(const BasicConstVectorView<T>& x,
+                     const BasicConstVectorView<T>& y);
+template <typename T>
+RealType<T> maxError(const BasicConstMatrixView<T>& A,
+                     const BasicConstMatrixView<T>& B);
+template <typename T>
+std::uint64_t maxUlpDistance(const BasicConstVectorView<T>& x,
+                             const BasicConstVectorView<T>& y);
+template <typename T>
+std::uint64_t maxUlpDistance(const BasicConstMatrixView<T>& A,
+                             const BasicConstMatrixView<T>& B);
+
+}  // namespace la
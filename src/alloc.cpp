@@ -0,0 +1,290 @@
+#include "inc/alloc.h"
+#include <algorithm>  // max()
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>  // less
+
+namespace la
+{
+
+namespace
+{
+
+// Columns shorter than this many bytes are not padded.
+const std::size_t PAD_THRESHOLD = 512;
+
+// Strides that are multiples of this many bytes map to a single cache set.
+const std::size_t ALIASING_STRIDE = 4096;
+
+// Size of the first chunk an arena allocates.
+const std::size_t MIN_CHUNK = 64 * 1024;
+
+std::atomic<std::size_t> heapCount{0};
+
+/**
+ * Allocates from the heap, aligned to ALIGNMENT bytes. The pointer returned
+ * by operator new is stored just before the aligned block.
+ */
+void* heapAllocate(std::size_t bytes)
+{
+    ++heapCount;
+    char* raw = static_cast<char*>(::operator new(bytes + ALIGNMENT));
+    std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(raw) + ALIGNMENT;
+    void** aligned = reinterpret_cast<void**>(addr & ~(ALIGNMENT - 1));
+    aligned[-1] = raw;
+    return aligned;
+}
+
+void heapDeallocate(void* p)
+{
+    ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+// Most chunks an arena can hold; chunks at least double in size.
+const std::size_t MAX_CHUNKS = 48;
+
+/**
+ * Arena: a list of chunks consumed by bumping an offset. Only the chunks
+ * up to and including the current one hold live allocations.
+ * Trivially destructible, so it stays usable while other thread-local and
+ * static objects are destroyed; its chunks are freed by an ArenaReleaser.
+ */
+struct Arena
+{
+    struct Chunk
+    {
+        char* base;
+        std::size_t size;
+    };
+
+    Chunk chunks[MAX_CHUNKS];
+    std::size_t count;  // number of chunks
+    std::size_t cur;    // index of the chunk being allocated from
+    std::size_t top;    // offset of the first free byte in chunks[cur]
+    int depth;          // number of live Workspaces on this thread
+
+    void* bump(std::size_t bytes)
+    {
+        while (cur == count || top + bytes > chunks[cur].size)
+        {
+            if (cur + 1 < count)
+            {
+                ++cur;
+            }
+            else
+            {
+                std::size_t size = (count == 0) ? MIN_CHUNK
+                                                : 2 * chunks[count - 1].size;
+                grow(std::max(size, bytes));
+                cur = count - 1;
+            }
+            top = 0;
+        }
+        void* p = chunks[cur].base + top;
+        top += bytes;
+        return p;
+    }
+
+    void grow(std::size_t size);
+
+    bool owns(const void* p) const
+    {
+        std::less<const void*> less;
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            if (!less(p, chunks[c].base)
+                && less(p, chunks[c].base + chunks[c].size))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t capacity() const
+    {
+        std::size_t total = 0;
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            total += chunks[c].size;
+        }
+        return total;
+    }
+
+    // Replaces the chunks by one large enough for all of them, so the next
+    // round of allocations is served from a single slab.
+    void coalesce()
+    {
+        assert(depth == 0);
+        if (count > 1)
+        {
+            std::size_t total = capacity();
+            release();
+            grow(total);
+        }
+        cur = 0;
+        top = 0;
+    }
+
+    void release()
+    {
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            heapDeallocate(chunks[c].base);
+        }
+        count = 0;
+        cur = 0;
+        top = 0;
+    }
+};
+
+thread_local Arena arena;  // zero-initialized
+
+// Frees the arena's chunks when its thread exits.
+struct ArenaReleaser
+{
+    bool armed = false;
+
+    ~ArenaReleaser()
+    {
+        arena.release();
+    }
+};
+
+thread_local ArenaReleaser releaser;
+
+void Arena::grow(std::size_t size)
+{
+    assert(count < MAX_CHUNKS);
+    releaser.armed = true;  // ensures the releaser is constructed
+    chunks[count++] = {static_cast<char*>(heapAllocate(size)), size};
+}
+
+std::size_t roundUp(std::size_t bytes)
+{
+    return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+}  // namespace
+
+Workspace::Workspace()
+: _chunk{arena.cur},
+  _offset{arena.top}
+{
+    ++arena.depth;
+}
+
+/**
+ * Releases everything allocated since the Workspace began, in O(1) unless
+ * this is the outermost Workspace and the arena outgrew its first chunk.
+ */
+Workspace::~Workspace()
+{
+    assert(arena.depth > 0);
+    --arena.depth;
+    arena.cur = _chunk;
+    arena.top = _offset;
+    if (arena.depth == 0)
+    {
+        arena.coalesce();
+    }
+}
+
+/**
+ * Ensures this thread's arena can hold at least the given number of bytes.
+ */
+void Workspace::reserve(std::size_t bytes)
+{
+    if (arena.capacity() < bytes && arena.depth == 0)
+    {
+        arena.release();
+        arena.grow(bytes);
+    }
+}
+
+std::size_t Workspace::capacity()
+{
+    return arena.capacity();
+}
+
+// Bytes currently allocated from this thread's arena.
+std::size_t Workspace::used()
+{
+    std::size_t total = arena.top;
+    for (std::size_t c = 0; c < arena.cur && c < arena.count; ++c)
+    {
+        total += arena.chunks[c].size;
+    }
+    return total;
+}
+
+/**
+ * Returns storage for the given number of bytes, aligned to ALIGNMENT
+ * bytes: from the arena if a Workspace is alive on this thread, otherwise
+ * from the heap.
+ */
+void* allocate(std::size_t bytes)
+{
+    if (arena.depth > 0)
+    {
+        return arena.bump(roundUp(bytes));
+    }
+    return heapAllocate(bytes);
+}
+
+/**
+ * Returns storage obtained from allocate(). Arena storage is reclaimed when
+ * its Workspace ends, except that the most recent allocation is reclaimed
+ * immediately, so short-lived temporaries reuse the same bytes.
+ */
+void deallocate(void* p, std::size_t bytes)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    if (!arena.owns(p))
+    {
+        heapDeallocate(p);
+        return;
+    }
+    char* end = static_cast<char*>(p) + roundUp(bytes);
+    if (arena.cur < arena.count
+        && end == arena.chunks[arena.cur].base + arena.top)
+    {
+        arena.top -= roundUp(bytes);
+    }
+}
+
+/**
+ * Returns the leading dimension (distance between consecutive columns, in
+ * entries) for a matrix with the given number of rows of scalars of the
+ * given size. Long columns are padded to whole cache lines, plus one more
+ * line if the stride would otherwise be a multiple of ALIASING_STRIDE, so
+ * walking along a row does not map every entry to the same cache set.
+ * Short columns are not padded, since the padding would dominate.
+ */
+int leadingDimension(int rows, std::size_t scalarSize)
+{
+    std::size_t bytes = rows * scalarSize;
+    if (bytes < PAD_THRESHOLD || ALIGNMENT % scalarSize != 0)
+    {
+        return rows;
+    }
+    bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (bytes % ALIASING_STRIDE == 0)
+    {
+        bytes += ALIGNMENT;
+    }
+    return bytes / scalarSize;
+}
+
+// Number of times storage has been taken from the heap, on any thread.
+std::size_t heapAllocations()
+{
+    return heapCount;
+}
+
+}  // namespace la
@@ -0,0 +1,223 @@
+#include "inc/binary.h"
+#include "inc/alloc.h"
+#include "inc/npy.h"
+#include <algorithm>  // max()
+#include <climits>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <utility>  // swap()
+#include <vector>
+
+namespace la
+{
+
+namespace
+{
+
+const char MAGIC[8] = {'L', 'A', 'M', 'A', 'T', 'R', 'I', 'X'};
+const std::uint32_t ORDER_MARK = 0x01020304;
+
+// The entries follow the header at the first aligned offset.
+const std::uint64_t DATA_OFFSET = ALIGNMENT;
+static_assert(sizeof(BinaryHeader) <= DATA_OFFSET, "header overlaps data");
+
+// 64-bit FNV-1a hash of n bytes, continuing from hash h.
+std::uint64_t fnv1a(const void* p, std::size_t n,
+                    std::uint64_t h = 0xcbf29ce484222325ULL)
+{
+    const unsigned char* b = static_cast<const unsigned char*>(p);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        h = (h ^ b[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/**
+ * Returns true if h describes a matrix of T that lies within a file of the
+ * given length and can be addressed with int indices.
+ */
+template <typename T>
+bool isValid(const BinaryHeader& h, std::size_t length)
+{
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0
+        || h.version != BINARY_VERSION || h.byteOrder != ORDER_MARK
+        || h.dtype != static_cast<std::uint32_t>(BinaryTypeOf<T>::value)
+        || h.layout != 0)
+    {
+        return false;
+    }
+    if (h.rows < 0 || h.cols < 0 || h.ld < std::max<std::int64_t>(h.rows, 1)
+        || h.ld > INT_MAX || h.cols > INT_MAX)
+    {
+        return false;
+    }
+    if (h.dataOffset < sizeof(BinaryHeader) || h.dataOffset % ALIGNMENT != 0
+        || h.dataOffset > length)
+    {
+        return false;
+    }
+    std::uint64_t entries = static_cast<std::uint64_t>(h.ld) * h.cols;
+    return entries * sizeof(T) <= length - h.dataOffset;
+}
+
+}  // namespace
+
+/**
+ * Writes A to a binary matrix file at path, padding each column to the
+ * leading dimension a Matrix of A's shape would have.
+ * Returns false if the file cannot be written.
+ */
+template <typename T>
+bool writeBinary(const std::string& path, const BasicConstMatrixView<T>& A)
+{
+    int ld = std::max(leadingDimension(A.rows(), sizeof(T)), 1);
+    BinaryHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = BINARY_VERSION;
+    h.byteOrder = ORDER_MARK;
+    h.dtype = static_cast<std::uint32_t>(BinaryTypeOf<T>::value);
+    h.layout = 0;
+    h.rows = A.rows();
+    h.cols = A.cols();
+    h.ld = ld;
+    h.dataOffset = DATA_OFFSET;
+
+    // The header is written again once the checksum is known.
+    std::ofstream out(path, std::ios::binary);
+    std::vector<char> lead(DATA_OFFSET, 0);
+    out.write(lead.data(), lead.size());
+    std::vector<T> column(ld, T(0));  // padding stays zero
+    std::uint64_t checksum = fnv1a(nullptr, 0);
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int i = 0; i < A.rows(); ++i)
+        {
+            column[i] = A(i, j);
+        }
+        out.write(reinterpret_cast<const char*>(column.data()),
+                  ld * sizeof(T));
+        checksum = fnv1a(column.data(), ld * sizeof(T), checksum);
+    }
+    h.checksum = checksum;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    return static_cast<bool>(out);
+}
+
+template <typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix()
+: BasicConstMatrixView<T>(nullptr, 0, 0, 1)
+{}
+
+template <typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix(BasicMappedMatrix<T>&& A)
+: BasicMappedMatrix()
+{
+    *this = std::move(A);
+}
+
+template <typename T>
+BasicMappedMatrix<T>::~BasicMappedMatrix()
+{
+    close();
+}
+
+template <typename T>
+BasicMappedMatrix<T>& BasicMappedMatrix<T>::operator=(
+    BasicMappedMatrix<T>&& A)
+{
+    std::swap(_p, A._p);
+    std::swap(_m, A._m);
+    std::swap(_n, A._n);
+    std::swap(_ld, A._ld);
+    std::swap(_file, A._file);
+    return *this;
+}
+
+/**
+ * Maps the binary matrix file or .npy file at path, closing any file
+ * already open. .npy files must hold a column-major array of T. If verify
+ * is true, the entries of a binary matrix file are read once to check the
+ * checksum. Returns false if the file cannot be mapped, does not hold a
+ * matrix of T, or fails verification.
+ */
+template <typename T>
+bool BasicMappedMatrix<T>::open(const std::string& path, bool verify)
+{
+    close();
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+
+    const char* data;
+    NpyHeader npy;
+    if (file.size() >= sizeof(BinaryHeader)
+        && std::memcmp(file.begin(), MAGIC, sizeof(MAGIC)) == 0)
+    {
+        const BinaryHeader& h = *reinterpret_cast<const BinaryHeader*>(
+            file.begin());
+        data = file.begin() + h.dataOffset;
+        if (!isValid<T>(h, file.size())
+            || (verify
+                && fnv1a(data, h.ld * h.cols * sizeof(T)) != h.checksum))
+        {
+            return false;
+        }
+        _m = h.rows;
+        _n = h.cols;
+        _ld = h.ld;
+    }
+    else if (parseNpyHeader(file.begin(), file.size(), npy)
+             && npy.dtype == BinaryTypeOf<T>::value
+             && (npy.fortranOrder || npy.rows == 1 || npy.cols == 1)
+             && npy.dataOffset % alignof(T) == 0)
+    {
+        data = file.begin() + npy.dataOffset;
+        _m = npy.rows;
+        _n = npy.cols;
+        _ld = std::max(npy.rows, 1);
+    }
+    else
+    {
+        return false;
+    }
+    _p = const_cast<T*>(reinterpret_cast<const T*>(data));
+    _file = std::move(file);
+    return true;
+}
+
+// Unmaps the file, if any, leaving an empty matrix.
+template <typename T>
+void BasicMappedMatrix<T>::close()
+{
+    _file.close();
+    _p = nullptr;
+    _m = 0;
+    _n = 0;
+    _ld = 1;
+}
+
+template <typename T>
+bool BasicMappedMatrix<T>::isOpen() const
+{
+    return _file.isOpen();
+}
+
+#define LA_INSTANTIATE_BINARY(T)                                              \
+    template bool writeBinary(const std::string&,                             \
+                              const BasicConstMatrixView<T>&);                \
+    template class BasicMappedMatrix<T>;
+
+LA_INSTANTIATE_BINARY(float)
+LA_INSTANTIATE_BINARY(double)
+LA_INSTANTIATE_BINARY(std::complex<float>)
+LA_INSTANTIATE_BINARY(std::complex<double>)
+
+#undef LA_INSTANTIATE_BINARY
+
+}  // namespace la
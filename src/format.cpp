@@ -0,0 +1,170 @@
+#include "inc/format.h"
+#include <algorithm>  // max()
+#include <cassert>
+#include <charconv>
+#include <complex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace la
+{
+
+namespace
+{
+
+// Output is handed to the stream in pieces of about this size.
+const std::size_t FLUSH_BYTES = 1 << 16;
+
+char* toChars(char* first, char* last, float x)
+{
+    return std::to_chars(first, last, x).ptr;
+}
+
+char* toChars(char* first, char* last, double x)
+{
+    return std::to_chars(first, last, x).ptr;
+}
+
+// Writes (re,im), as operator<< does for std::complex.
+template <typename T>
+char* toChars(char* first, char* last, std::complex<T> x)
+{
+    *first++ = '(';
+    first = toChars(first, last, x.real());
+    *first++ = ',';
+    first = toChars(first, last, x.imag());
+    *first++ = ')';
+    return first;
+}
+
+// Appends the row of A as "(a, b, c)", padding entry j to width[j].
+template <typename T>
+void appendRow(std::string& out, const BasicConstMatrixView<T>& A, int i,
+               const std::vector<int>& width)
+{
+    char s[MAX_SCALAR_CHARS];
+    out += '(';
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        if (j > 0)
+        {
+            out += ", ";
+        }
+        int len = formatScalar(s, s + MAX_SCALAR_CHARS, A(i, j)) - s;
+        out.append(std::max(width[j] - len, 0), ' ');
+        out.append(s, len);
+    }
+    out += ')';
+}
+
+}  // namespace
+
+/**
+ * Writes the shortest text that reads back as x to [first, last), which
+ * must hold at least MAX_SCALAR_CHARS characters. Returns the end of the
+ * text.
+ */
+template <typename T>
+char* formatScalar(char* first, char* last, T x)
+{
+    assert(last - first >= MAX_SCALAR_CHARS);
+    return toChars(first, last, x);
+}
+
+template <typename T>
+void print(std::ostream& os, const BasicConstVectorView<T>& x)
+{
+    char s[MAX_SCALAR_CHARS];
+    std::string out = "(";
+    for (int i = 0; i < x.size(); ++i)
+    {
+        if (i > 0)
+        {
+            out += ", ";
+        }
+        out.append(s, formatScalar(s, s + MAX_SCALAR_CHARS, x[i]));
+        if (out.size() >= FLUSH_BYTES)
+        {
+            os.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+    out += ')';
+    os.write(out.data(), out.size());
+}
+
+/**
+ * Writes A one row per line, with each column right-aligned to its widest
+ * written entry. The widths are found by a pass down the columns before
+ * the rows are written, so output streams out without being held whole.
+ */
+template <typename T>
+void print(std::ostream& os, const BasicConstMatrixView<T>& A,
+           FormatOptions options)
+{
+    int m = A.rows();
+    bool truncate = options.head >= 0 && options.tail >= 0
+                    && options.head + options.tail < m;
+    int head = truncate ? options.head : m;
+    int tail = truncate ? options.tail : 0;
+
+    // Rows [0, head) and [m - tail, m) are written.
+    std::vector<int> width(A.cols(), 0);
+    char s[MAX_SCALAR_CHARS];
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        const T* c = A.data() + j * A.ld();
+        auto measure = [&](int lo, int hi)
+        {
+            for (int i = lo; i < hi; ++i)
+            {
+                int len = formatScalar(s, s + MAX_SCALAR_CHARS, c[i]) - s;
+                width[j] = std::max(width[j], len);
+            }
+        };
+        measure(0, head);
+        measure(m - tail, m);
+    }
+
+    std::string out;
+    int lines = head + tail + (truncate ? 1 : 0);
+    for (int k = 0; k < lines; ++k)
+    {
+        out += (k == 0 ? '(' : ' ');
+        if (k < head)
+        {
+            appendRow(out, A, k, width);
+        }
+        else if (truncate && k == head)
+        {
+            out += "...";
+        }
+        else
+        {
+            appendRow(out, A, m - (lines - k), width);
+        }
+        out += (k == lines - 1 ? ")\n" : "\n");
+        if (out.size() >= FLUSH_BYTES)
+        {
+            os.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+    os.write(out.data(), out.size());
+}
+
+#define LA_INSTANTIATE_FORMAT(T)                                              \
+    template char* formatScalar(char*, char*, T);                             \
+    template void print(std::ostream&, const BasicConstVectorView<T>&);       \
+    template void print(std::ostream&, const BasicConstMatrixView<T>&,        \
+                        FormatOptions);
+
+LA_INSTANTIATE_FORMAT(float)
+LA_INSTANTIATE_FORMAT(double)
+LA_INSTANTIATE_FORMAT(std::complex<float>)
+LA_INSTANTIATE_FORMAT(std::complex<double>)
+
+#undef LA_INSTANTIATE_FORMAT
+
+}  // namespace la
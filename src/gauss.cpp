@@ -1,20 +1,128 @@
 #include "inc/gauss.h"
+#include "inc/instrument.h"
+#include "inc/trace.h"
 #include "inc/util.h"
-#include <algorithm>  // min()
-#include <utility>
+#include <algorithm>  // copy(), min()
+#include <utility>  // swap()
 #include <cmath>
 #include <cassert>
 
 namespace la
 {
 
+namespace
+{
+
+/**
+ * Adds f[k] times row r of A to row rows[k] for each k, in the columns from
+ * lo on. Does the work of a replaceRow() per row, but sweeps each column of
+ * A once instead of striding across all the columns once per row.
+ */
+template <typename T>
+void replaceRows(BasicMatrix<T>& A, const std::vector<int>& rows,
+                 const std::vector<T>& f, int r, int lo)
+{
+    assert(rows.size() == f.size());
+    assert(r >= 0 && r < A.rows());
+    assert(lo >= 0);
+
+    int count = static_cast<int>(rows.size());
+    int ld = A.ld();
+    T* c = A.data() + static_cast<std::size_t>(lo) * ld;
+    for (int j = lo; j < A.cols(); ++j, c += ld)
+    {
+        T x = c[r];
+        for (int k = 0; k < count; ++k)
+        {
+            c[rows[k]] += f[k] * x;
+        }
+    }
+    LA_ADD_WORK(2.0 * count * (A.cols() - lo),
+                3.0 * count * (A.cols() - lo) * sizeof(T));
+    for (int k = 0; k < count; ++k)
+    {
+        trace::record(trace::EventType::Replace, rows[k], r, lo, f[k]);
+    }
+}
+
+/**
+ * Reduces V by row replacements to a permuted echelon form, recording the
+ * multipliers in L unless it is null. Returns dest such that row i of V is
+ * row dest[i] of the echelon form.
+ */
+template <typename T>
+std::vector<int> reduceRows(BasicMatrix<T>& V, PivotSelector<T> pivotSelector,
+                            BasicMatrix<T>* L)
+{
+    int m = V.rows(), n = V.cols();
+    if (L != nullptr)
+    {
+        fill(*L, T(0));
+    }
+    std::vector<int> dest(m);
+    std::set<int> rows;  // tracks rows not yet covered
+    for (int i = 0; i < m; ++i)
+    {
+        rows.insert(i);
+    }
+
+    std::vector<int> targets;
+    std::vector<T> factors;
+    int pivotCount = 0;
+    for (int j = 0; j < n && pivotCount < std::min(m, n); ++j)
+    {
+        int pivotRow = (*pivotSelector)(V[j], rows);
+        if (pivotRow == -1)
+        {
+            continue;  // zero column
+        }
+        trace::record(trace::EventType::Pivot, pivotRow, -1, j,
+                      V[j][pivotRow]);
+        dest[pivotRow] = pivotCount;
+        rows.erase(pivotRow);
+        if (L != nullptr)
+        {
+            (*L)[pivotCount][pivotRow] = T(1);
+        }
+        T pivot = V(pivotRow, j);
+        targets.assign(rows.begin(), rows.end());
+        factors.resize(targets.size());
+        for (std::size_t k = 0; k < targets.size(); ++k)
+        {
+            T v = V(targets[k], j);
+            if (L != nullptr)
+            {
+                (*L)[pivotCount][targets[k]] = v / pivot;
+            }
+            factors[k] = -v / pivot;
+        }
+        replaceRows(V, targets, factors, pivotRow, j);
+        ++pivotCount;
+    }
+
+    // Handle any non-pivot (zero) rows in V.
+    for (int i : rows)
+    {
+        if (L != nullptr)
+        {
+            (*L)[pivotCount][i] = T(1);
+        }
+        dest[i] = pivotCount;
+        ++pivotCount;
+    }
+    return dest;
+}
+
+}  // namespace
+
 /**
  * Applies Gaussian elimination to A.
  * On return, A is in reduced echelon form.
  */
-void eliminate(Matrix& A,
-               int (*pivotSelector)(const Vector&, const std::set<int>&))
+template <typename T>
+void eliminate(BasicMatrix<T>& A, PivotSelector<T> pivotSelector)
 {
+    LA_PROFILE("eliminate", 0, 0);
     forwardReduce(A, pivotSelector);
     backwardReduce(A);
 }
@@ -23,27 +131,44 @@ void eliminate(Matrix& A,
  * Applies row operations to A.
  * On return, A is in echelon form.
  */
-void forwardReduce(Matrix& A,
-                   int (*pivotSelector)(const Vector&, const std::set<int>&))
+template <typename T>
+void forwardReduce(BasicMatrix<T>& A, PivotSelector<T> pivotSelector)
 {
-    Matrix temp(A.rows(), A.rows());
-    Matrix U(A.rows(), A.cols());
-    factor(A, pivotSelector, temp, U);
-    A = U;
+    LA_PROFILE("forwardReduce", 0, 0);
+    std::vector<int> dest = reduceRows(A, pivotSelector,
+                                       static_cast<BasicMatrix<T>*>(nullptr));
+
+    // Move each row of A to its place in the echelon form by following the
+    // cycles of the permutation, then moving all the rows at once.
+    RowPermutation P(A.rows());
+    for (int i = 0; i < A.rows(); ++i)
+    {
+        while (dest[i] != i)
+        {
+            int d = dest[i];
+            P.swap(i, d);
+            std::swap(dest[i], dest[d]);
+        }
+    }
+    permuteRows(A, P);
 }
 
 /**
  * Applies row operations to (assumed echelon) U.
  * On return, U is in reduced echelon form.
  */
-void backwardReduce(Matrix& U)
+template <typename T>
+void backwardReduce(BasicMatrix<T>& U)
 {
+    LA_PROFILE("backwardReduce", 0, 0);
+    std::vector<int> above;
+    std::vector<T> factors;
     for (int i = U.rows() - 1, j = U.cols() - 1; i >= 0 && j >= 0; )
     {
         // Update j to column index of leftmost nonzero entry of row i.
         // Take the entry at row i and column j as pivot.
         int pivotCol = 0;
-        while (pivotCol <= j && approxEqual(U[pivotCol][i], 0.0F))
+        while (pivotCol <= j && approxEqual(U(i, pivotCol), T(0)))
         {
             ++pivotCol;
         }
@@ -56,13 +181,18 @@ void backwardReduce(Matrix& U)
         j = pivotCol;
 
         // Use pivot to create zeros above it.
+        T pivot = U(i, j);
+        above.resize(i);
+        factors.resize(i);
         for (int k = i - 1; k >= 0; --k)
         {
-            replaceRow(U, k, i, -U[j][k] / U[j][i], j);
+            above[i - 1 - k] = k;
+            factors[i - 1 - k] = -U(k, j) / pivot;
         }
+        replaceRows(U, above, factors, i, j);
 
         // Scale ith row such that pivot is 1.
-        scaleRow(U, i, 1.0F / U[j][i], j);
+        scaleRow(U, i, T(1) / pivot, j);
 
         --i;
         --j;
@@ -74,56 +204,30 @@ void backwardReduce(Matrix& U)
  * On return, L is (m x m) permuted unit lower triangular,
  * U is an echelon form of A, and A = LU.
  */
-void factor(const Matrix& A,
-            int (*pivotSelector)(const Vector&, const std::set<int>&),
-            Matrix& L, Matrix& U)
+template <typename T>
+void factor(const BasicMatrix<T>& A, PivotSelector<T> pivotSelector,
+            BasicMatrix<T>& L, BasicMatrix<T>& U)
 {
-    int m = A.rows(), n = A.cols();
+    LA_PROFILE("factor", 0, 0);
+    int m = A.rows();
     assert(L.rows() == m && L.cols() == m);
-    assert(U.rows() == m && U.cols() == n);
+    assert(U.rows() == m && U.cols() == A.cols());
 
-    L *= 0.0F;
-    Matrix V = A;
+    BasicMatrix<T> V = A;
+    std::vector<int> dest = reduceRows(V, pivotSelector, &L);
     std::map<int, int> perm;  // row i of V corresponds to row perm[i] of U
-    std::set<int> rows;  // tracks rows not yet covered
     for (int i = 0; i < m; ++i)
     {
-        rows.insert(i);
-    }
-
-    // Reduce V to a permuted echelon form of A while filling in L.
-    int pivotCount = 0;
-    for (int j = 0; j < n && pivotCount < std::min(m, n); ++j)
-    {
-        int pivotRow = (*pivotSelector)(V[j], rows);
-        if (pivotRow == -1)
-        {
-            continue;  // zero column
-        }
-        perm[pivotRow] = pivotCount;
-        rows.erase(pivotRow);
-        L[pivotCount][pivotRow] = 1.0F;
-        for (int i : rows)
-        {
-            L[pivotCount][i] = V[j][i] / V[j][pivotRow];
-            replaceRow(V, i, pivotRow, -V[j][i] / V[j][pivotRow], j);
-        }
-        ++pivotCount;
-    }
-
-    // Handle any non-pivot (zero) rows in V.
-    for (int i : rows)
-    {
-        L[pivotCount][i] = 1.0F;
-        perm[i] = pivotCount;
-        ++pivotCount;
+        perm[i] = dest[i];
     }
 
     // Fill in U from V and the recorded permutation.
     permute(V, perm, U);
 }
 
-void permute(const Matrix& V, const std::map<int, int>& perm, Matrix& U)
+template <typename T>
+void permute(const BasicMatrix<T>& V, const std::map<int, int>& perm,
+             BasicMatrix<T>& U)
 {
     assert(V.rows() == U.rows() && V.cols() == U.cols());
     assert(V.rows() == perm.size());
@@ -139,15 +243,104 @@ void permute(const Matrix& V, const std::map<int, int>& perm, Matrix& U)
     }
 }
 
-int partialPivotSelector(const Vector& c, const std::set<int>& rows)
+/**
+ * Factors square A in place as P A = L U by partial pivoting.
+ * On return, the strictly lower triangle of A holds L (whose unit diagonal
+ * is implicit), the upper triangle holds U, and row k was interchanged with
+ * row piv[k] at step k. Returns false if A is singular.
+ */
+template <typename T>
+bool luFactor(BasicMatrix<T>& A, std::vector<int>& piv)
+{
+    LA_PROFILE("luFactor", 0, 0);
+    assert(isSquare(A));
+    int n = A.rows();
+    piv.resize(n);
+    for (int k = 0; k < n; ++k)
+    {
+        T* ck = A[k].begin();
+        int p = k;
+        for (int i = k + 1; i < n; ++i)
+        {
+            if (std::abs(ck[i]) > std::abs(ck[p]))
+            {
+                p = i;
+            }
+        }
+        piv[k] = p;
+        trace::record(trace::EventType::Pivot, p, -1, k, ck[p]);
+        if (ck[p] == T(0))
+        {
+            return false;
+        }
+        swapRows(A, k, p);
+        // Work on the trailing submatrix, of order n - k - 1.
+        LA_ADD_WORK((n - k - 1) * (2.0 * (n - k - 1) + 1),
+                    (n - k - 1) * (2.0 * (n - k - 1) + 2) * sizeof(T));
+
+        T scale = T(1) / ck[k];
+        for (int i = k + 1; i < n; ++i)
+        {
+            ck[i] *= scale;
+        }
+        for (int j = k + 1; j < n; ++j)
+        {
+            T* cj = A[j].begin();
+            T f = cj[k];
+            for (int i = k + 1; i < n; ++i)
+            {
+                cj[i] -= ck[i] * f;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Solves A x = b given the factorization of A computed by luFactor().
+ * On return, b holds x.
+ */
+template <typename T>
+void luSolve(const BasicMatrix<T>& LU, const std::vector<int>& piv,
+             BasicVector<T>& b)
 {
-    float maxVal = 0.0F;
+    int n = LU.rows();
+    assert(isSquare(LU) && b.size() == n && static_cast<int>(piv.size()) == n);
+    LA_PROFILE("luSolve", 2.0 * n * n, (1.0 * n * n + 2.0 * n) * sizeof(T));
+    T* x = b.begin();
+    for (int k = 0; k < n; ++k)
+    {
+        std::swap(x[k], x[piv[k]]);
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        const T* cj = LU[j].begin();
+        for (int i = j + 1; i < n; ++i)
+        {
+            x[i] -= cj[i] * x[j];
+        }
+    }
+    for (int j = n - 1; j >= 0; --j)
+    {
+        const T* cj = LU[j].begin();
+        x[j] /= cj[j];
+        for (int i = 0; i < j; ++i)
+        {
+            x[i] -= cj[i] * x[j];
+        }
+    }
+}
+
+template <typename T>
+int partialPivotSelector(const BasicVector<T>& c, const std::set<int>& rows)
+{
+    RealType<T> maxVal = 0;
     int pivotRow = -1;
     for (int i : rows)
     {
         assert(i >= 0 && i < c.size());
-        float val = std::abs(c[i]);
-        if (val > maxVal && !approxEqual(val, 0.0F))
+        RealType<T> val = std::abs(c[i]);
+        if (val > maxVal && !approxEqual(val, RealType<T>(0)))
         {
             maxVal = val;
             pivotRow = i;
@@ -156,12 +349,14 @@ int partialPivotSelector(const Vector& c, const std::set<int>& rows)
     return pivotRow;
 }
 
-int firstNonzeroPivotSelector(const Vector& c, const std::set<int>& rows)
+template <typename T>
+int firstNonzeroPivotSelector(const BasicVector<T>& c,
+                              const std::set<int>& rows)
 {
     for (int i : rows)
     {
         assert(i >= 0 && i < c.size());
-        if (!approxEqual(c[i], 0.0F))
+        if (!approxEqual(c[i], T(0)))
         {
             return i;
         }
@@ -169,7 +364,8 @@ int firstNonzeroPivotSelector(const Vector& c, const std::set<int>& rows)
     return -1;
 }
 
-void swapRows(Matrix& A, int i1, int i2, int lo)
+template <typename T>
+void swapRows(BasicMatrix<T>& A, int i1, int i2, int lo)
 {
     assert(i1 >= 0 && i1 < A.rows());
     assert(i2 >= 0 && i2 < A.rows());
@@ -179,40 +375,149 @@ void swapRows(Matrix& A, int i1, int i2, int lo)
     {
         return;
     }
-    for (int j = lo; j < A.cols(); ++j)
+    int ld = A.ld();
+    T* c = A.data() + static_cast<std::size_t>(lo) * ld;
+    for (int j = lo; j < A.cols(); ++j, c += ld)
     {
-        std::swap(A[j][i1], A[j][i2]);
+        std::swap(c[i1], c[i2]);
     }
-    // std::cerr << "swap R" << i1 << " and R" << i2 << std::endl;
-    // std::cerr << A << std::endl;
+    LA_ADD_WORK(0, 4.0 * (A.cols() - lo) * sizeof(T));
+    trace::record(trace::EventType::Swap, i1, i2, lo, T(0));
 }
 
-void scaleRow(Matrix& A, int i, float f, int lo)
+template <typename T>
+void scaleRow(BasicMatrix<T>& A, int i, typename BasicMatrix<T>::value_type f,
+              int lo)
 {
     assert(i >= 0 && i < A.rows());
     assert(lo >= 0);
 
-    for (int j = lo; j < A.cols(); ++j)
+    int ld = A.ld();
+    T* c = A.data() + static_cast<std::size_t>(lo) * ld;
+    for (int j = lo; j < A.cols(); ++j, c += ld)
     {
-        A[j][i] *= f;
+        c[i] *= f;
     }
-    // std::cerr << "scale R" << i << " by " << f << '\n';
-    // std::cerr << A << std::endl;
+    LA_ADD_WORK(A.cols() - lo, 2.0 * (A.cols() - lo) * sizeof(T));
+    trace::record(trace::EventType::Scale, i, -1, lo, f);
 }
 
-void replaceRow(Matrix& A, int i1, int i2, float f, int lo)
+template <typename T>
+void replaceRow(BasicMatrix<T>& A, int i1, int i2,
+                typename BasicMatrix<T>::value_type f, int lo)
 {
     assert(i1 >= 0 && i1 < A.rows());
     assert(i2 >= 0 && i2 < A.rows());
     assert(lo >= 0);
 
-    for (int j = lo; j < A.cols(); ++j)
+    int ld = A.ld();
+    T* c = A.data() + static_cast<std::size_t>(lo) * ld;
+    for (int j = lo; j < A.cols(); ++j, c += ld)
     {
-        A[j][i1] += f * A[j][i2];
+        c[i1] += f * c[i2];
     }
-    // std::cerr << "replace R" << i1 << " with R" << i1;
-    // std::cerr << " + (" << f << " * R" << i2 << ")\n";
-    // std::cerr << A << std::endl;
+    LA_ADD_WORK(2.0 * (A.cols() - lo), 3.0 * (A.cols() - lo) * sizeof(T));
+    trace::record(trace::EventType::Replace, i1, i2, lo, f);
 }
 
+/**
+ * Moves row P[i] of A to row i for every i, gathering one column at a time
+ * into a scratch column.
+ */
+template <typename T>
+void permuteRows(BasicMatrix<T>& A, const RowPermutation& P)
+{
+    int m = A.rows();
+    assert(P.size() == m);
+
+    std::vector<int> src(m);
+    bool identity = true;
+    for (int i = 0; i < m; ++i)
+    {
+        src[i] = P[i];
+        identity = identity && src[i] == i;
+    }
+    if (identity)
+    {
+        return;
+    }
+    std::vector<T> scratch(m);
+    int ld = A.ld();
+    T* c = A.data();
+    for (int j = 0; j < A.cols(); ++j, c += ld)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            scratch[i] = c[src[i]];
+        }
+        std::copy(scratch.begin(), scratch.end(), c);
+    }
+    LA_ADD_WORK(0, 3.0 * m * A.cols() * sizeof(T));
+}
+
+RowPermutation::RowPermutation(int m)
+: _src(m)
+{
+    assert(m > 0);
+    for (int i = 0; i < m; ++i)
+    {
+        _src[i] = i;
+    }
+}
+
+int RowPermutation::size() const
+{
+    return static_cast<int>(_src.size());
+}
+
+int RowPermutation::operator[](int i) const
+{
+    assert(i >= 0 && i < size());
+    return _src[i];
+}
+
+/**
+ * Interchanges rows i1 and i2 of the permuted matrix. The trace records it
+ * as the swapRows() it stands for.
+ */
+void RowPermutation::swap(int i1, int i2)
+{
+    assert(i1 >= 0 && i1 < size());
+    assert(i2 >= 0 && i2 < size());
+
+    if (i1 == i2)
+    {
+        return;
+    }
+    std::swap(_src[i1], _src[i2]);
+    trace::record(trace::EventType::Swap, i1, i2, 0, 0.0);
+}
+
+#define LA_INSTANTIATE_GAUSS(T)                                               \
+    template void eliminate(BasicMatrix<T>&, PivotSelector<T>);               \
+    template void forwardReduce(BasicMatrix<T>&, PivotSelector<T>);           \
+    template void backwardReduce(BasicMatrix<T>&);                            \
+    template void factor(const BasicMatrix<T>&, PivotSelector<T>,             \
+                         BasicMatrix<T>&, BasicMatrix<T>&);                   \
+    template void permute(const BasicMatrix<T>&, const std::map<int, int>&,   \
+                          BasicMatrix<T>&);                                   \
+    template bool luFactor(BasicMatrix<T>&, std::vector<int>&);               \
+    template void luSolve(const BasicMatrix<T>&, const std::vector<int>&,     \
+                          BasicVector<T>&);                                   \
+    template int partialPivotSelector(const BasicVector<T>&,                  \
+                                      const std::set<int>&);                  \
+    template int firstNonzeroPivotSelector(const BasicVector<T>&,             \
+                                           const std::set<int>&);             \
+    template void swapRows(BasicMatrix<T>&, int, int, int);                   \
+    template void scaleRow(BasicMatrix<T>&, int, T, int);                     \
+    template void replaceRow(BasicMatrix<T>&, int, int, T, int);             \
+    template void permuteRows(BasicMatrix<T>&, const RowPermutation&);
+
+LA_INSTANTIATE_GAUSS(float)
+LA_INSTANTIATE_GAUSS(double)
+LA_INSTANTIATE_GAUSS(std::complex<float>)
+LA_INSTANTIATE_GAUSS(std::complex<double>)
+
+#undef LA_INSTANTIATE_GAUSS
+
 }  // namespace la
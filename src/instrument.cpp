@@ -0,0 +1,133 @@
+#include "inc/instrument.h"
+#include "inc/alloc.h"
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+namespace la
+{
+
+namespace instrument
+{
+
+namespace
+{
+
+std::mutex registryMutex;
+
+// Deque, so Counters never move once handed out.
+std::deque<Counter>& registry()
+{
+    static std::deque<Counter> counters;
+    return counters;
+}
+
+thread_local Scope* current = nullptr;  // innermost Scope on this thread
+
+}  // namespace
+
+// Returns true if the library was built with LA_INSTRUMENT.
+bool enabled()
+{
+#ifdef LA_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the totals of every operation called so far, in the order the
+ * operations were first called.
+ */
+std::vector<OpStats> snapshot()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<OpStats> stats;
+    for (const Counter& c : registry())
+    {
+        stats.push_back({c.name, c.calls, c.flops, c.bytes, c.allocations,
+                         c.nanos * 1e-9});
+    }
+    return stats;
+}
+
+void reset()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (Counter& c : registry())
+    {
+        c.calls = 0;
+        c.flops = 0;
+        c.bytes = 0;
+        c.allocations = 0;
+        c.nanos = 0;
+    }
+}
+
+/**
+ * Returns the Counter of the named operation, creating it on first use.
+ * Call sites keep the reference, so this runs once per site.
+ */
+Counter& counter(const char* name)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (Counter& c : registry())
+    {
+        if (std::strcmp(c.name, name) == 0)
+        {
+            return c;
+        }
+    }
+    registry().emplace_back();
+    Counter& c = registry().back();
+    c.name = name;
+    c.calls = 0;
+    c.flops = 0;
+    c.bytes = 0;
+    c.allocations = 0;
+    c.nanos = 0;
+    return c;
+}
+
+// Adds work done inside the innermost operation on this thread.
+void addWork(double flops, double bytes)
+{
+    if (current != nullptr)
+    {
+        current->_flops += flops;
+        current->_bytes += bytes;
+    }
+}
+
+Scope::Scope(Counter& c, double flops, double bytes)
+: _c(c),
+  _parent{current},
+  _flops{flops},
+  _bytes{bytes},
+  _allocs{heapAllocations()},
+  _start{std::chrono::steady_clock::now()}
+{
+    current = this;
+}
+
+Scope::~Scope()
+{
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    current = _parent;
+    if (_parent != nullptr)
+    {
+        _parent->_flops += _flops;
+        _parent->_bytes += _bytes;
+    }
+    ++_c.calls;
+    _c.flops += static_cast<std::uint64_t>(_flops);
+    _c.bytes += static_cast<std::uint64_t>(_bytes);
+    _c.allocations += heapAllocations() - _allocs;
+    _c.nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                    .count();
+}
+
+}  // namespace instrument
+
+}  // namespace la
@@ -0,0 +1,492 @@
+#include "inc/krylov.h"
+#include "inc/instrument.h"
+#include <cassert>
+#include <cmath>
+
+namespace la
+{
+
+namespace
+{
+
+double dot(const Vector& v, const Vector& w)
+{
+    const float* vp = v.begin();
+    const float* wp = w.begin();
+    double sum = 0.0;
+    for (int i = 0, n = v.size(); i < n; ++i)
+    {
+        sum += vp[i] * wp[i];
+    }
+    return sum;
+}
+
+}  // namespace
+
+ConjugateGradient::ConjugateGradient(int n, float tol, int maxIter)
+: _tol{tol},
+  _maxIter{maxIter > 0 ? maxIter : n},
+  _iters{0},
+  _res{0.0F},
+  _r(n),
+  _z(n),
+  _p(n),
+  _q(n)
+{
+    assert(tol > 0.0F);
+}
+
+/**
+ * Solves A x = b starting from the initial guess in x.
+ * Returns true if the residual tolerance was met, and false if the
+ * iteration limit was reached or A was found not to be positive definite.
+ */
+bool ConjugateGradient::solve(const LinearOperator& A, const Vector& b,
+                              Vector& x, const LinearOperator* M)
+{
+    LA_PROFILE("ConjugateGradient::solve", 0, 0);
+    int n = _r.size();
+    assert(A.rows() == n && A.cols() == n);
+    assert(b.size() == n && x.size() == n);
+    assert(M == nullptr || (M->rows() == n && M->cols() == n));
+
+    float* xp = x.begin();
+    float* rp = _r.begin();
+    float* pp = _p.begin();
+    const float* qp = _q.begin();
+    const float* bp = b.begin();
+
+    _iters = 0;
+    double bnorm = std::sqrt(dot(b, b));
+    if (bnorm == 0.0)
+    {
+        x *= 0.0F;
+        _res = 0.0F;
+        return true;
+    }
+
+    A.apply(x, _q);
+    double rr = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        rp[i] = bp[i] - qp[i];
+        rr += rp[i] * rp[i];
+    }
+    _res = std::sqrt(rr) / bnorm;
+    if (_res <= _tol)
+    {
+        return true;
+    }
+
+    // Without a preconditioner z is r itself.
+    const Vector& z = M ? _z : _r;
+    if (M)
+    {
+        M->apply(_r, _z);
+    }
+    const float* zp = z.begin();
+    double rz = M ? dot(_r, z) : rr;
+    for (int i = 0; i < n; ++i)
+    {
+        pp[i] = zp[i];
+    }
+
+    while (_iters < _maxIter)
+    {
+        A.apply(_p, _q);
+        double pq = dot(_p, _q);
+        if (pq <= 0.0)
+        {
+            return false;  // A is not positive definite
+        }
+        float alpha = rz / pq;
+
+        // Fused update of the iterate and residual.
+        rr = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            xp[i] += alpha * pp[i];
+            rp[i] -= alpha * qp[i];
+            rr += rp[i] * rp[i];
+        }
+        ++_iters;
+        _res = std::sqrt(rr) / bnorm;
+        if (_res <= _tol)
+        {
+            return true;
+        }
+
+        double rzNew = rr;
+        if (M)
+        {
+            M->apply(_r, _z);
+            rzNew = dot(_r, _z);
+        }
+        float beta = rzNew / rz;
+        rz = rzNew;
+        for (int i = 0; i < n; ++i)
+        {
+            pp[i] = zp[i] + beta * pp[i];
+        }
+    }
+    return false;
+}
+
+int ConjugateGradient::iterations() const
+{
+    return _iters;
+}
+
+float ConjugateGradient::residual() const
+{
+    return _res;
+}
+
+GMRES::GMRES(int n, int restart, float tol, int maxIter)
+: _tol{tol},
+  _restart{restart},
+  _maxIter{maxIter > 0 ? maxIter : 10 * n},
+  _iters{0},
+  _res{0.0F},
+  _h((restart + 1) * restart),
+  _cs(restart),
+  _sn(restart),
+  _g(restart + 1),
+  _hj(restart + 1),
+  _w(n),
+  _z(n)
+{
+    assert(restart > 0 && tol > 0.0F);
+    _v.reserve(restart + 1);
+    for (int j = 0; j <= restart; ++j)
+    {
+        _v.emplace_back(n);
+    }
+}
+
+/**
+ * Solves A x = b starting from the initial guess in x.
+ * Returns true if the residual tolerance was met, and false if the
+ * iteration limit was reached first.
+ */
+bool GMRES::solve(const LinearOperator& A, const Vector& b, Vector& x,
+                  const LinearOperator* M)
+{
+    LA_PROFILE("GMRES::solve", 0, 0);
+    int n = _w.size();
+    int mr = _restart;
+    assert(A.rows() == n && A.cols() == n);
+    assert(b.size() == n && x.size() == n);
+    assert(M == nullptr || (M->rows() == n && M->cols() == n));
+
+    float* wp = _w.begin();
+    const float* bp = b.begin();
+    auto H = [this, mr](int i, int j) -> float& { return _h[j * (mr + 1) + i]; };
+
+    _iters = 0;
+    double bnorm = std::sqrt(dot(b, b));
+    if (bnorm == 0.0)
+    {
+        x *= 0.0F;
+        _res = 0.0F;
+        return true;
+    }
+
+    while (true)
+    {
+        // Start a cycle from the true residual.
+        A.apply(x, _w);
+        float* v0 = _v[0].begin();
+        double rr = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            v0[i] = bp[i] - wp[i];
+            rr += v0[i] * v0[i];
+        }
+        float beta = std::sqrt(rr);
+        _res = beta / bnorm;
+        if (_res <= _tol)
+        {
+            return true;
+        }
+        if (_iters >= _maxIter)
+        {
+            return false;
+        }
+        _v[0] *= 1.0F / beta;
+        _g.assign(mr + 1, 0.0F);
+        _g[0] = beta;
+
+        int k = 0;  // dimension of the Krylov subspace built this cycle
+        while (k < mr && _iters < _maxIter)
+        {
+            int j = k;
+            if (M)
+            {
+                M->apply(_v[j], _z);
+                A.apply(_z, _w);
+            }
+            else
+            {
+                A.apply(_v[j], _w);
+            }
+
+            // Classical Gram-Schmidt, twice.
+            for (int i = 0; i <= j; ++i)
+            {
+                H(i, j) = 0.0F;
+            }
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (int i = 0; i <= j; ++i)
+                {
+                    _hj[i] = dot(_v[i], _w);
+                }
+                for (int i = 0; i <= j; ++i)
+                {
+                    const float* vi = _v[i].begin();
+                    float hij = _hj[i];
+                    for (int l = 0; l < n; ++l)
+                    {
+                        wp[l] -= hij * vi[l];
+                    }
+                    H(i, j) += hij;
+                }
+            }
+            float hNext = std::sqrt(dot(_w, _w));
+            H(j + 1, j) = hNext;
+            if (hNext != 0.0F)
+            {
+                float* vNext = _v[j + 1].begin();
+                float scale = 1.0F / hNext;
+                for (int l = 0; l < n; ++l)
+                {
+                    vNext[l] = scale * wp[l];
+                }
+            }
+
+            // Apply the previous rotations to the new column, then find
+            // the rotation that eliminates its subdiagonal entry.
+            for (int i = 0; i < j; ++i)
+            {
+                float t = _cs[i] * H(i, j) + _sn[i] * H(i + 1, j);
+                H(i + 1, j) = -_sn[i] * H(i, j) + _cs[i] * H(i + 1, j);
+                H(i, j) = t;
+            }
+            float a = H(j, j);
+            float c = H(j + 1, j);
+            float rho = std::sqrt(a * a + c * c);
+            _cs[j] = (rho != 0.0F) ? a / rho : 1.0F;
+            _sn[j] = (rho != 0.0F) ? c / rho : 0.0F;
+            H(j, j) = rho;
+            H(j + 1, j) = 0.0F;
+            _g[j + 1] = -_sn[j] * _g[j];
+            _g[j] = _cs[j] * _g[j];
+
+            ++k;
+            ++_iters;
+            _res = std::abs(_g[k]) / bnorm;
+            if (_res <= _tol || hNext == 0.0F)
+            {
+                break;  // converged or found an invariant subspace
+            }
+        }
+
+        // Solve the triangular system H y = g in place in g, then update
+        // x += M^-1 V y.
+        for (int i = k - 1; i >= 0; --i)
+        {
+            float sum = _g[i];
+            for (int l = i + 1; l < k; ++l)
+            {
+                sum -= H(i, l) * _g[l];
+            }
+            _g[i] = (H(i, i) != 0.0F) ? sum / H(i, i) : 0.0F;
+        }
+        _w *= 0.0F;
+        for (int i = 0; i < k; ++i)
+        {
+            const float* vi = _v[i].begin();
+            float yi = _g[i];
+            for (int l = 0; l < n; ++l)
+            {
+                wp[l] += yi * vi[l];
+            }
+        }
+        if (M)
+        {
+            M->apply(_w, _z);
+            x += _z;
+        }
+        else
+        {
+            x += _w;
+        }
+    }
+}
+
+int GMRES::iterations() const
+{
+    return _iters;
+}
+
+float GMRES::residual() const
+{
+    return _res;
+}
+
+BiCGSTAB::BiCGSTAB(int n, float tol, int maxIter)
+: _tol{tol},
+  _maxIter{maxIter > 0 ? maxIter : n},
+  _iters{0},
+  _res{0.0F},
+  _r(n),
+  _rHat(n),
+  _p(n),
+  _v(n),
+  _s(n),
+  _t(n),
+  _pHat(n),
+  _sHat(n)
+{
+    assert(tol > 0.0F);
+}
+
+/**
+ * Solves A x = b starting from the initial guess in x.
+ * Returns true if the residual tolerance was met, and false if the
+ * iteration limit was reached or the method broke down.
+ */
+bool BiCGSTAB::solve(const LinearOperator& A, const Vector& b, Vector& x,
+                     const LinearOperator* M)
+{
+    LA_PROFILE("BiCGSTAB::solve", 0, 0);
+    int n = _r.size();
+    assert(A.rows() == n && A.cols() == n);
+    assert(b.size() == n && x.size() == n);
+    assert(M == nullptr || (M->rows() == n && M->cols() == n));
+
+    float* xp = x.begin();
+    float* rp = _r.begin();
+    float* pp = _p.begin();
+    float* sp = _s.begin();
+    const float* vp = _v.begin();
+    const float* tp = _t.begin();
+    const float* bp = b.begin();
+
+    // Without a preconditioner the hatted vectors are the unhatted ones.
+    Vector& pHat = M ? _pHat : _p;
+    Vector& sHat = M ? _sHat : _s;
+    const float* php = pHat.begin();
+    const float* shp = sHat.begin();
+
+    _iters = 0;
+    double bnorm = std::sqrt(dot(b, b));
+    if (bnorm == 0.0)
+    {
+        x *= 0.0F;
+        _res = 0.0F;
+        return true;
+    }
+
+    A.apply(x, _v);
+    double rr = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        rp[i] = bp[i] - vp[i];
+        rr += rp[i] * rp[i];
+    }
+    _rHat = _r;
+    _res = std::sqrt(rr) / bnorm;
+    if (_res <= _tol)
+    {
+        return true;
+    }
+
+    double rho = 1.0;
+    float alpha = 1.0F;
+    float omega = 1.0F;
+    _v *= 0.0F;
+    _p *= 0.0F;
+    while (_iters < _maxIter)
+    {
+        double rhoNew = dot(_rHat, _r);
+        if (rhoNew == 0.0)
+        {
+            return false;  // breakdown
+        }
+        float beta = (rhoNew / rho) * (alpha / omega);
+        rho = rhoNew;
+        for (int i = 0; i < n; ++i)
+        {
+            pp[i] = rp[i] + beta * (pp[i] - omega * vp[i]);
+        }
+        if (M)
+        {
+            M->apply(_p, pHat);
+        }
+        A.apply(pHat, _v);
+        double rv = dot(_rHat, _v);
+        if (rv == 0.0)
+        {
+            return false;  // breakdown
+        }
+        alpha = rho / rv;
+
+        double ss = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            sp[i] = rp[i] - alpha * vp[i];
+            ss += sp[i] * sp[i];
+        }
+        ++_iters;
+        if (std::sqrt(ss) / bnorm <= _tol)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                xp[i] += alpha * php[i];
+            }
+            _res = std::sqrt(ss) / bnorm;
+            return true;
+        }
+
+        if (M)
+        {
+            M->apply(_s, sHat);
+        }
+        A.apply(sHat, _t);
+        double tt = dot(_t, _t);
+        omega = (tt != 0.0) ? dot(_t, _s) / tt : 0.0F;
+
+        // Fused update of the iterate and residual.
+        rr = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            xp[i] += alpha * php[i] + omega * shp[i];
+            rp[i] = sp[i] - omega * tp[i];
+            rr += rp[i] * rp[i];
+        }
+        _res = std::sqrt(rr) / bnorm;
+        if (_res <= _tol)
+        {
+            return true;
+        }
+        if (omega == 0.0F)
+        {
+            return false;  // breakdown
+        }
+    }
+    return false;
+}
+
+int BiCGSTAB::iterations() const
+{
+    return _iters;
+}
+
+float BiCGSTAB::residual() const
+{
+    return _res;
+}
+
+}  // namespace la
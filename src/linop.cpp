@@ -0,0 +1,101 @@
+#include "inc/linop.h"
+#include <cassert>
+#include <utility>
+
+namespace la
+{
+
+DenseOperator::DenseOperator(const Matrix& A)
+: _A(A)
+{}
+
+int DenseOperator::rows() const
+{
+    return _A.rows();
+}
+
+int DenseOperator::cols() const
+{
+    return _A.cols();
+}
+
+void DenseOperator::apply(const Vector& x, Vector& y) const
+{
+    assert(x.size() == _A.cols() && y.size() == _A.rows());
+    int m = _A.rows();
+    float* yp = y.begin();
+    for (int i = 0; i < m; ++i)
+    {
+        yp[i] = 0.0F;
+    }
+    for (int j = 0; j < _A.cols(); ++j)
+    {
+        const float* a = _A[j].begin();
+        float xj = x[j];
+        for (int i = 0; i < m; ++i)
+        {
+            yp[i] += a[i] * xj;
+        }
+    }
+}
+
+SparseOperator::SparseOperator(const SparseMatrix& A)
+: _A(A)
+{}
+
+int SparseOperator::rows() const
+{
+    return _A.rows();
+}
+
+int SparseOperator::cols() const
+{
+    return _A.cols();
+}
+
+void SparseOperator::apply(const Vector& x, Vector& y) const
+{
+    assert(x.size() == _A.cols() && y.size() == _A.rows());
+    const int* cp = _A.colPtr().data();
+    const int* ri = _A.rowIdx().data();
+    const float* vals = _A.values().data();
+    float* yp = y.begin();
+    for (int i = 0; i < _A.rows(); ++i)
+    {
+        yp[i] = 0.0F;
+    }
+    for (int j = 0; j < _A.cols(); ++j)
+    {
+        float xj = x[j];
+        for (int p = cp[j]; p < cp[j + 1]; ++p)
+        {
+            yp[ri[p]] += vals[p] * xj;
+        }
+    }
+}
+
+CallbackOperator::CallbackOperator(int m, int n, Callback f)
+: _m{m},
+  _n{n},
+  _f{std::move(f)}
+{
+    assert(m > 0 && n > 0 && _f);
+}
+
+int CallbackOperator::rows() const
+{
+    return _m;
+}
+
+int CallbackOperator::cols() const
+{
+    return _n;
+}
+
+void CallbackOperator::apply(const Vector& x, Vector& y) const
+{
+    assert(x.size() == _n && y.size() == _m);
+    _f(x, y);
+}
+
+}  // namespace la
@@ -0,0 +1,102 @@
+#include "inc/mapped.h"
+#include <utility>  // swap()
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace la
+{
+
+MappedFile::MappedFile()
+: _data{nullptr},
+  _size{0}
+{}
+
+MappedFile::MappedFile(MappedFile&& f)
+: MappedFile()
+{
+    *this = std::move(f);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& f)
+{
+    std::swap(_data, f._data);
+    std::swap(_size, f._size);
+    return *this;
+}
+
+/**
+ * Maps the file at path, closing any file already mapped.
+ * Returns false if the file cannot be mapped or is empty.
+ */
+bool MappedFile::open(const std::string& path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file open
+    if (p == MAP_FAILED)
+    {
+        return false;
+    }
+    _data = static_cast<const char*>(p);
+    _size = st.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+    _data = nullptr;
+    _size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return _data != nullptr;
+}
+
+// Tells the kernel the file will be read front to back, for readahead.
+void MappedFile::adviseSequential() const
+{
+    if (_data != nullptr)
+    {
+        ::madvise(const_cast<char*>(_data), _size, MADV_SEQUENTIAL);
+    }
+}
+
+const char* MappedFile::begin() const
+{
+    return _data;
+}
+
+const char* MappedFile::end() const
+{
+    return _data + _size;
+}
+
+std::size_t MappedFile::size() const
+{
+    return _size;
+}
+
+}  // namespace la
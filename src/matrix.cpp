@@ -1,37 +1,197 @@
 #include "inc/matrix.h"
 #include "inc/util.h"
 #include "inc/gauss.h"
+#include "inc/alloc.h"
+#include "inc/format.h"
+#include "inc/instrument.h"
+#include "inc/random.h"
 #include <cassert>
 #include <cmath>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
 #include <algorithm>
+#include <thread>
+#include <utility>  // swap()
+#include <vector>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
 
 namespace la
 {
 
-Matrix::Matrix(int m, int n)
+namespace
+{
+
+// Side of the blocks at which the recursive transposes stop subdividing.
+const int TRANSPOSE_BLOCK = 8;
+
+// Splits n in two, keeping the first part a whole number of blocks.
+int splitPoint(int n)
+{
+    return (n / 2 + TRANSPOSE_BLOCK - 1) & ~(TRANSPOSE_BLOCK - 1);
+}
+
+/**
+ * Writes the transpose of the m x n column-major block at a to the
+ * n x m column-major block at b.
+ */
+template <typename T>
+void transposeBlock(const T* a, int lda, T* b, int ldb, int m, int n)
+{
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            b[j + i * ldb] = a[i + j * lda];
+        }
+    }
+}
+
+#if defined(__SSE__)
+// Full 8 x 8 float blocks are transposed as four 4 x 4 register tiles.
+void transposeBlock(const float* a, int lda, float* b, int ldb, int m, int n)
+{
+    if (m != TRANSPOSE_BLOCK || n != TRANSPOSE_BLOCK)
+    {
+        transposeBlock<float>(a, lda, b, ldb, m, n);
+        return;
+    }
+    for (int r = 0; r < 8; r += 4)
+    {
+        for (int c = 0; c < 8; c += 4)
+        {
+            const float* src = a + r + c * lda;
+            __m128 c0 = _mm_loadu_ps(src);
+            __m128 c1 = _mm_loadu_ps(src + lda);
+            __m128 c2 = _mm_loadu_ps(src + 2 * lda);
+            __m128 c3 = _mm_loadu_ps(src + 3 * lda);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            float* dst = b + c + r * ldb;
+            _mm_storeu_ps(dst, c0);
+            _mm_storeu_ps(dst + ldb, c1);
+            _mm_storeu_ps(dst + 2 * ldb, c2);
+            _mm_storeu_ps(dst + 3 * ldb, c3);
+        }
+    }
+}
+#endif
+
+/**
+ * Cache-oblivious out-of-place transpose: halves the longer side of the
+ * m x n block at a until it fits in a single block.
+ */
+template <typename T>
+void transposeRec(const T* a, int lda, T* b, int ldb, int m, int n)
+{
+    if (m <= TRANSPOSE_BLOCK && n <= TRANSPOSE_BLOCK)
+    {
+        transposeBlock(a, lda, b, ldb, m, n);
+    }
+    else if (m >= n)
+    {
+        int h = splitPoint(m);
+        transposeRec(a, lda, b, ldb, h, n);
+        transposeRec(a + h, lda, b + h * ldb, ldb, m - h, n);
+    }
+    else
+    {
+        int h = splitPoint(n);
+        transposeRec(a, lda, b, ldb, m, h);
+        transposeRec(a + h * lda, lda, b + h, ldb, m, n - h);
+    }
+}
+
+/**
+ * Swaps the m x n block at a with the transpose of the n x m block at b,
+ * both with leading dimension ld.
+ */
+template <typename T>
+void transposeSwap(T* a, T* b, int ld, int m, int n)
+{
+    if (m <= TRANSPOSE_BLOCK && n <= TRANSPOSE_BLOCK)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                std::swap(a[i + j * ld], b[j + i * ld]);
+            }
+        }
+    }
+    else if (m >= n)
+    {
+        int h = splitPoint(m);
+        transposeSwap(a, b, ld, h, n);
+        transposeSwap(a + h, b + h * ld, ld, m - h, n);
+    }
+    else
+    {
+        int h = splitPoint(n);
+        transposeSwap(a, b, ld, m, h);
+        transposeSwap(a + h * ld, b + h, ld, m, n - h);
+    }
+}
+
+/**
+ * Transposes the n x n block at a in place: transposes the two diagonal
+ * quadrants recursively and swaps the off-diagonal ones.
+ */
+template <typename T>
+void transposeDiag(T* a, int ld, int n)
+{
+    if (n <= TRANSPOSE_BLOCK)
+    {
+        for (int j = 1; j < n; ++j)
+        {
+            for (int i = 0; i < j; ++i)
+            {
+                std::swap(a[i + j * ld], a[j + i * ld]);
+            }
+        }
+        return;
+    }
+    int h = splitPoint(n);
+    transposeDiag(a, ld, h);
+    transposeDiag(a + h + h * ld, ld, n - h);
+    transposeSwap(a + h, a + h * ld, ld, n - h, h);
+}
+
+}  // namespace
+
+template <typename T>
+BasicMatrix<T>::BasicMatrix(int m, int n)
+: BasicMatrix(m, n, LeadingDim{leadingDimension(m, sizeof(T))})
+{}
+
+template <typename T>
+BasicMatrix<T>::BasicMatrix(int m, int n, LeadingDim ld)
+: BasicMatrixView<T>(nullptr, m, n, ld.value)
 {
     assert(m > 0 && n > 0);
-    _m = m;
-    _n = n;
+
+    // Allocate the entries as a single column-major block.
+    _p = allocateArray<T>(_ld * _n);
+    for (int k = 0; k < _ld * _n; ++k)
+    {
+        new (_p + k) T;
+    }
 
     // Allocate enough memory for an array of n (column) Vectors.
-    _bp = operator new[](_n * sizeof(Vector));
+    _bp = allocate(_n * sizeof(BasicVector<T>));
 
     // Make _cp point to it so it can be treated as a Vector array.
-    _cp = static_cast<Vector*>(_bp);
+    _cp = static_cast<BasicVector<T>*>(_bp);
 
-    // Construct the Vectors in the memory using "placement new".
+    // Construct Vectors referring to the columns using "placement new".
     for (int j = 0; j < _n; ++j)
     {
-        new (_cp + j) Vector(_m);
+        new (_cp + j) BasicVector<T>(_p + j * _ld, _m, false);
     }
 }
 
-Matrix::Matrix(int m, int n, float initVal)
-: Matrix(m, n)
+template <typename T>
+BasicMatrix<T>::BasicMatrix(int m, int n, T initVal)
+: BasicMatrix(m, n)
 {
     for (int j = 0; j < _n; ++j)
     {
@@ -42,8 +202,9 @@ Matrix::Matrix(int m, int n, float initVal)
     }
 }
 
-Matrix::Matrix(const Matrix& A)
-: Matrix(A._m, A._n)
+template <typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix<T>& A)
+: BasicMatrix(A._m, A._n)
 {
     for (int j = 0; j < _n; ++j)
     {
@@ -51,19 +212,29 @@ Matrix::Matrix(const Matrix& A)
     }
 }
 
-Matrix::~Matrix()
+template <typename T>
+BasicMatrix<T>::BasicMatrix(const BasicConstMatrixView<T>& A)
+: BasicMatrix(A.rows(), A.cols())
+{
+    copy(A, *this);
+}
+
+template <typename T>
+BasicMatrix<T>::~BasicMatrix()
 {
     // Destruct the Vectors in reverse order of construction.
     for (int j = _n - 1; j >= 0; --j)
     {
-        _cp[j].~Vector();
+        _cp[j].~BasicVector();
     }
 
-    // Deallocate the raw memory.
-    operator delete[](_bp);
+    // Deallocate the raw memory and the entries.
+    deallocate(_bp, _n * sizeof(BasicVector<T>));
+    deallocateArray(_p, _ld * _n);
 }
 
-Matrix& Matrix::operator=(const Matrix& A)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const BasicMatrix<T>& A)
 {
     assert(_m == A._m && _n == A._n);
     for (int j = 0; j < _n; ++j)
@@ -73,7 +244,8 @@ Matrix& Matrix::operator=(const Matrix& A)
     return *this;
 }
 
-Matrix& Matrix::operator+=(const Matrix& A)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const BasicMatrix<T>& A)
 {
     assert(_m == A._m && _n == A._n);
     for (int j = 0; j < _n; ++j)
@@ -83,7 +255,8 @@ Matrix& Matrix::operator+=(const Matrix& A)
     return *this;
 }
 
-Matrix& Matrix::operator-=(const Matrix& A)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const BasicMatrix<T>& A)
 {
     assert(_m == A._m && _n == A._n);
     for (int j = 0; j < _n; ++j)
@@ -93,7 +266,8 @@ Matrix& Matrix::operator-=(const Matrix& A)
     return *this;
 }
 
-Matrix& Matrix::operator*=(float f)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(T f)
 {
     for (int j = 0; j < _n; ++j)
     {
@@ -102,59 +276,129 @@ Matrix& Matrix::operator*=(float f)
     return *this;
 }
 
-Vector& Matrix::operator[](int j)
+template <typename T>
+BasicVector<T>& BasicMatrix<T>::operator[](int j)
 {
     assert(j >= 0 && j < _n);
     return _cp[j];
 }
 
-const Vector& Matrix::operator[](int j) const
+template <typename T>
+const BasicVector<T>& BasicMatrix<T>::operator[](int j) const
 {
     assert(j >= 0 && j < _n);
     return _cp[j];
 }
 
-Vector* Matrix::begin()
+template <typename T>
+BasicVector<T>* BasicMatrix<T>::begin()
 {
     return _cp;
 }
 
-const Vector* Matrix::begin() const
+template <typename T>
+const BasicVector<T>* BasicMatrix<T>::begin() const
 {
     return _cp;
 }
 
-Vector* Matrix::end()
+template <typename T>
+BasicVector<T>* BasicMatrix<T>::end()
 {
     return _cp + _n;
 }
 
-const Vector* Matrix::end() const
+template <typename T>
+const BasicVector<T>* BasicMatrix<T>::end() const
 {
     return _cp + _n;
 }
 
-int Matrix::rows() const
+template <typename T>
+T& BasicMatrix<T>::operator()(int i, int j)
+{
+    return BasicMatrixView<T>::operator()(i, j);
+}
+
+template <typename T>
+const T& BasicMatrix<T>::operator()(int i, int j) const
+{
+    return BasicConstMatrixView<T>::operator()(i, j);
+}
+
+template <typename T>
+T* BasicMatrix<T>::data()
+{
+    return _p;
+}
+
+template <typename T>
+const T* BasicMatrix<T>::data() const
+{
+    return _p;
+}
+
+template <typename T>
+BasicMatrixView<T> BasicMatrix<T>::block(int i, int j, int m, int n)
+{
+    return BasicMatrixView<T>::block(i, j, m, n);
+}
+
+template <typename T>
+BasicConstMatrixView<T> BasicMatrix<T>::block(int i, int j, int m, int n) const
+{
+    return BasicConstMatrixView<T>::block(i, j, m, n);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrix<T>::row(int i)
+{
+    return BasicMatrixView<T>::row(i);
+}
+
+template <typename T>
+BasicConstVectorView<T> BasicMatrix<T>::row(int i) const
+{
+    return BasicConstMatrixView<T>::row(i);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrix<T>::col(int j)
+{
+    return BasicMatrixView<T>::col(j);
+}
+
+template <typename T>
+BasicConstVectorView<T> BasicMatrix<T>::col(int j) const
+{
+    return BasicConstMatrixView<T>::col(j);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrix<T>::diag()
 {
-    return _m;
+    return BasicMatrixView<T>::diag();
 }
 
-int Matrix::cols() const
+template <typename T>
+BasicConstVectorView<T> BasicMatrix<T>::diag() const
 {
-    return _n;
+    return BasicConstMatrixView<T>::diag();
 }
 
-Matrix Matrix::fromRows(std::initializer_list<Vector> rlist)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::fromRows(
+    std::initializer_list<BasicVector<T>> rlist)
 {
     assert(rlist.size() > 0);
     int m = rlist.size();
     int n = rlist.begin()->size();
-    la::Matrix A(m, n);
+    BasicMatrix<T> A(m, n);
     int i = 0;
-    for (const Vector& r : rlist)
+    for (const BasicVector<T>& r : rlist)
     {
         int j = 0;
-        for (float entry : r)
+        for (T entry : r)
         {
             A[j++][i] = entry;
         }
@@ -163,24 +407,27 @@ Matrix Matrix::fromRows(std::initializer_list<Vector> rlist)
     return A;
 }
 
-Matrix Matrix::fromCols(std::initializer_list<Vector> clist)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::fromCols(
+    std::initializer_list<BasicVector<T>> clist)
 {
     assert(clist.size() > 0);
     int m = clist.begin()->size();
     int n = clist.size();
-    la::Matrix A(m, n);
+    BasicMatrix<T> A(m, n);
     int j = 0;
-    for (const Vector& c : clist)
+    for (const BasicVector<T>& c : clist)
     {
         A[j++] = c;
     }
     return A;
 }
 
-Matrix Matrix::fromDiag(const Vector& d)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::fromDiag(const BasicVector<T>& d)
 {
     int n = d.size();
-    Matrix D(n, n, 0.0F);
+    BasicMatrix<T> D(n, n, T(0));
     for (int j = 0; j < n; ++j)
     {
         D[j][j] = d[j];
@@ -188,28 +435,28 @@ Matrix Matrix::fromDiag(const Vector& d)
     return D;
 }
 
-Matrix Matrix::identity(int n)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::identity(int n)
 {
-    return fromDiag(Vector(n, 1.0F));
+    return fromDiag(BasicVector<T>(n, T(1)));
 }
 
-Matrix Matrix::random(int m, int n)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::random(int m, int n)
 {
-    Matrix R(m, n);
-    for (Vector& c : R)
-    {
-        c = Vector::random(m);
-    }
-    return R;
+    return random(m, n, T(0), unitCorner(T(0)));
 }
 
-Matrix Matrix::random(int m, int n, float lo, float hi)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::random(int m, int n, T lo, T hi)
 {
-    assert(hi >= lo);
-    return (hi - lo) * random(m, n) + Matrix(m, n, lo);
+    BasicMatrix R(m, n);
+    fillUniform(R, randomSeed(), lo, hi);
+    return R;
 }
 
-bool operator==(const Matrix& A, const Matrix& B)
+template <typename T>
+bool operator==(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
     if (&A == &B)
     {
@@ -229,83 +476,81 @@ bool operator==(const Matrix& A, const Matrix& B)
     return true;
 }
 
-bool operator!=(const Matrix& A, const Matrix& B)
+template <typename T>
+bool operator!=(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
     return !(A == B);
 }
 
-Matrix operator+(const Matrix& A, const Matrix& B)
+template <typename T>
+BasicMatrix<T> operator+(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
-    return Matrix(A) += B;
+    LA_PROFILE("operator+(Matrix, Matrix)", 1.0 * A.rows() * A.cols(),
+               3.0 * A.rows() * A.cols() * sizeof(T));
+    BasicMatrix<T> result(A);
+    result += B;
+    return result;
 }
 
-Matrix operator-(const Matrix& A, const Matrix& B)
+template <typename T>
+BasicMatrix<T> operator-(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
-    return Matrix(A) -= B;
+    LA_PROFILE("operator-(Matrix, Matrix)", 1.0 * A.rows() * A.cols(),
+               3.0 * A.rows() * A.cols() * sizeof(T));
+    BasicMatrix<T> result(A);
+    result -= B;
+    return result;
 }
 
-Matrix operator*(const Matrix& A, float f)
+template <typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T>& A,
+                         typename BasicMatrix<T>::value_type f)
 {
-    return Matrix(A) *= f;
+    BasicMatrix<T> result(A);
+    result *= f;
+    return result;
 }
 
-Matrix operator*(float f, const Matrix& A)
+template <typename T>
+BasicMatrix<T> operator*(typename BasicMatrix<T>::value_type f,
+                         const BasicMatrix<T>& A)
 {
-    return Matrix(A) *= f;
+    BasicMatrix<T> result(A);
+    result *= f;
+    return result;
 }
 
-Vector operator*(const Matrix& A, const Vector& x)
+template <typename T>
+BasicVector<T> operator*(const BasicMatrix<T>& A, const BasicVector<T>& x)
 {
     assert(A.cols() == x.size());
-    Vector b(A.rows(), 0.0F);
-    for (int j = 0; j < A.cols(); ++j)
-    {
-        b += x[j] * A[j];
-    }
+    LA_PROFILE("operator*(Matrix, Vector)", 0, 0);
+    BasicVector<T> b(A.rows());
+    gemv(T(1), A, x, T(0), b);
     return b;
 }
 
-Matrix operator*(const Matrix& A, const Matrix& B)
+template <typename T>
+BasicMatrix<T> operator*(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
     assert(A.cols() == B.rows());
-    Matrix M(A.rows(), B.cols());
-    for (int j = 0; j < B.cols(); ++j)
-    {
-        M[j] = A * B[j];
-    }
+    LA_PROFILE("operator*(Matrix, Matrix)", 0, 0);
+    BasicMatrix<T> M(A.rows(), B.cols());
+    gemm(Op::NoTrans, Op::NoTrans, T(1), A, B, T(0), M);
     return M;
 }
 
-std::ostream& operator<<(std::ostream& os, const Matrix& A)
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& A)
 {
-    int maxw[A.cols()];  // max width of default-formatted floats in A by column
-    std::ostringstream oss;
-    for (int j = 0; j < A.cols(); ++j)
-    {
-        maxw[j] = 0;
-        for (float entry : A[j])
-        {
-            oss.str("");
-            oss << entry;
-            int w = oss.str().size();
-            maxw[j] = std::max(maxw[j], w);
-        }
-    }
-    for (int i = 0, m = A.rows(); i < m; ++i)
-    {
-        os << (i == 0 ? "((" : " (");
-        for (int j = 0, n = A.cols(); j < n; ++j)
-        {
-            os << (j > 0 ? ", " : "") << std::setw(maxw[j]) << A[j][i];
-        }
-        os << (i == m - 1 ? "))\n" : ")\n");
-    }
+    print(os, A);
     return os;
 }
 
-Matrix round(const Matrix& A, float epsilon)
+template <typename T>
+BasicMatrix<T> round(const BasicMatrix<T>& A, RealType<T> epsilon)
 {
-    Matrix B(A.rows(), A.cols());
+    BasicMatrix<T> B(A.rows(), A.cols());
     for (int j = 0; j < B.cols(); ++j)
     {
         B[j] = round(A[j], epsilon);
@@ -313,37 +558,31 @@ Matrix round(const Matrix& A, float epsilon)
     return B;
 }
 
-bool approxEqual(const Matrix& A, const Matrix& B, float epsilon)
+template <typename T>
+bool approxEqual(const BasicMatrix<T>& A, const BasicMatrix<T>& B,
+                 RealType<T> epsilon)
 {
     if (&A == &B)
     {
         return true;
     }
-    if (A.rows() != B.rows() || A.cols() != B.cols())
-    {
-        return false;
-    }
-    for (int j = 0; j < A.cols(); ++j)
-    {
-        if (!approxEqual(A[j], B[j], epsilon))
-        {
-            return false;
-        }
-    }
-    return true;
+    return approxEqual(static_cast<const BasicConstMatrixView<T>&>(A), B,
+                       epsilon);
 }
 
-Matrix augment(const Matrix& A, const Vector& b)
+template <typename T>
+BasicMatrix<T> augment(const BasicMatrix<T>& A, const BasicVector<T>& b)
 {
-    return augment(A, Matrix::fromCols({b}));
+    return augment(A, BasicMatrix<T>::fromCols({b}));
 }
 
-Matrix augment(const Matrix& A, const Matrix& B)
+template <typename T>
+BasicMatrix<T> augment(const BasicMatrix<T>& A, const BasicMatrix<T>& B)
 {
     assert(A.rows() == B.rows());
     int m = A.rows();
     int n = A.cols() + B.cols();
-    Matrix aug(m, n);
+    BasicMatrix<T> aug(m, n);
     for (int j = 0; j < n; ++j)
     {
         for (int i = 0; i < m; ++i)
@@ -354,114 +593,130 @@ Matrix augment(const Matrix& A, const Matrix& B)
     return aug;
 }
 
-Matrix deleteRow(const Matrix& A, int i)
+template <typename T>
+BasicMatrix<T> deleteRow(const BasicMatrix<T>& A, int i)
 {
     assert(i >= 0 && i < A.rows());
-    Matrix B(A.rows() - 1, A.cols());
-    int iB = 0;
-    for (int iA = 0; iA < A.rows(); ++iA)
-    {
-        if (iA == i)
-        {
-            continue;
-        }
-        for (int j = 0; j < A.cols(); ++j)
-        {
-            B[j][iB] = A[j][iA];
-        }
-        ++iB;
-    }
+    int m = A.rows();
+    int n = A.cols();
+    BasicMatrix<T> B(m - 1, n);
+    copy(A.block(0, 0, i, n), B.block(0, 0, i, n));
+    copy(A.block(i + 1, 0, m - i - 1, n), B.block(i, 0, m - i - 1, n));
     return B;
 }
 
-Matrix deleteCol(const Matrix& A, int j)
+template <typename T>
+BasicMatrix<T> deleteCol(const BasicMatrix<T>& A, int j)
 {
     assert(j >= 0 && j < A.cols());
-    Matrix B(A.rows(), A.cols() - 1);
-    int jB = 0;
-    for (int jA = 0; jA < A.cols(); ++jA)
-    {
-        if (jA == j)
-        {
-            continue;
-        }
-        B[jB] = A[jA];
-        ++jB;
-    }
+    int m = A.rows();
+    int n = A.cols();
+    BasicMatrix<T> B(m, n - 1);
+    copy(A.block(0, 0, m, j), B.block(0, 0, m, j));
+    copy(A.block(0, j + 1, m, n - j - 1), B.block(0, j, m, n - j - 1));
     return B;
 }
 
-Matrix deleteRowAndCol(const Matrix& A, int i, int j)
+template <typename T>
+BasicMatrix<T> deleteRowAndCol(const BasicMatrix<T>& A, int i, int j)
 {
     assert(i >= 0 && i < A.rows() && j >= 0 && j < A.cols());
-    Matrix B(A.rows() - 1, A.cols() - 1);
-    int jB = 0;
-    for (int jA = 0; jA < A.cols(); ++jA)
-    {
-        if (jA == j)
-        {
-            continue;
-        }
-        int iB = 0;
-        for (int iA = 0; iA < A.rows(); ++iA)
-        {
-            if (iA == i)
-            {
-                continue;
-            }
-            B[jB][iB] = A[jA][iA];
-            ++iB;
-        }
-        ++jB;
-    }
+    int m = A.rows();
+    int n = A.cols();
+    BasicMatrix<T> B(m - 1, n - 1);
+    int below = m - i - 1;
+    int right = n - j - 1;
+    copy(A.block(0, 0, i, j), B.block(0, 0, i, j));
+    copy(A.block(0, j + 1, i, right), B.block(0, j, i, right));
+    copy(A.block(i + 1, 0, below, j), B.block(i, 0, below, j));
+    copy(A.block(i + 1, j + 1, below, right), B.block(i, j, below, right));
     return B;
 }
 
-Matrix partition(const Matrix& A, std::pair<int, int> topLeft,
-                 std::pair<int, int> bottomRight)
+/**
+ * Returns a copy of the block of A between topLeft and bottomRight
+ * (inclusive). Use A.block() for a view that does not copy.
+ */
+template <typename T>
+BasicMatrix<T> partition(const BasicMatrix<T>& A, std::pair<int, int> topLeft,
+                         std::pair<int, int> bottomRight)
 {
     int m = bottomRight.first - topLeft.first + 1;
     int n = bottomRight.second - topLeft.second + 1;
     assert(m > 0 && m <= A.rows() && n > 0 && n <= A.cols());
-    Matrix B(m, n);
-    for (int j = 0; j < n; ++j)
-    {
-        for (int i = 0; i < m; ++i)
-        {
-            B[j][i] = A[topLeft.second + j][topLeft.first + i];
-        }
-    }
-    return B;
+    return BasicMatrix<T>(A.block(topLeft.first, topLeft.second, m, n));
 }
 
-bool isSquare(const Matrix& A)
+template <typename T>
+bool isSquare(const BasicMatrix<T>& A)
 {
     return A.rows() == A.cols();
 }
 
-bool isInvertible(const Matrix& A)
+template <typename T>
+bool isInvertible(const BasicMatrix<T>& A)
 {
-    Matrix temp(A.rows(), A.cols());
+    BasicMatrix<T> temp(A.rows(), A.cols());
     return inverse(A, temp);
 }
 
-Matrix pow(const Matrix& A, unsigned int k)
+template <typename T>
+BasicMatrix<T> pow(const BasicMatrix<T>& A, unsigned int k)
 {
-    return (k == 0) ? Matrix::identity(A.rows()) : A * pow(A, k - 1);
+    return (k == 0) ? BasicMatrix<T>::identity(A.rows()) : A * pow(A, k - 1);
 }
 
-Matrix transpose(const Matrix& A)
+template <typename T>
+BasicMatrix<T> transpose(const BasicMatrix<T>& A)
 {
-    Matrix T(A.cols(), A.rows());
-    for (int j = 0; j < A.cols(); ++j)
+    BasicMatrix<T> AT(A.cols(), A.rows());
+    transpose(A, AT);
+    return AT;
+}
+
+/**
+ * Writes the transpose of A to AT, which must not overlap A.
+ * The rows of A are divided between the given number of threads.
+ */
+template <typename T>
+void transpose(const BasicConstMatrixView<T>& A, const BasicMatrixView<T>& AT,
+               int threads)
+{
+    assert(A.rows() == AT.cols() && A.cols() == AT.rows() && threads > 0);
+    LA_PROFILE("transpose", 0, 2.0 * A.rows() * A.cols() * sizeof(T));
+    int m = A.rows();
+    int n = A.cols();
+    int chunk = (m + threads - 1) / threads;
+    chunk = (chunk + TRANSPOSE_BLOCK - 1) & ~(TRANSPOSE_BLOCK - 1);
+    if (threads == 1 || chunk >= m)
     {
-        // Set jth row of T equal to the jth column of A.
-        for (int i = 0; i < A.rows(); ++i)
-        {
-            T[i][j] = A[j][i];
-        }
+        transposeRec(A.data(), A.ld(), AT.data(), AT.ld(), m, n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int lo = chunk; lo < m; lo += chunk)
+    {
+        workers.emplace_back(transposeRec<T>, A.data() + lo, A.ld(),
+                             AT.data() + lo * AT.ld(), AT.ld(),
+                             std::min(chunk, m - lo), n);
+    }
+    transposeRec(A.data(), A.ld(), AT.data(), AT.ld(), chunk, n);
+    for (std::thread& t : workers)
+    {
+        t.join();
     }
-    return T;
+}
+
+/**
+ * Transposes the square matrix A in place.
+ */
+template <typename T>
+void transposeInPlace(const BasicMatrixView<T>& A)
+{
+    assert(A.rows() == A.cols());
+    LA_PROFILE("transposeInPlace", 0,
+               2.0 * A.rows() * A.cols() * sizeof(T));
+    transposeDiag(A.data(), A.ld(), A.rows());
 }
 
 /**
@@ -469,9 +724,11 @@ Matrix transpose(const Matrix& A)
  * If A is invertible, writes inverse to AInv and returns true,
  * otherwise returns false.
  */
-bool inverse(const Matrix& A, Matrix& AInv)
+template <typename T>
+bool inverse(const BasicMatrix<T>& A, BasicMatrix<T>& AInv)
 {
     assert(A.rows() == AInv.rows() && A.cols() == AInv.cols());
+    LA_PROFILE("inverse", 0, 0);
     if (!isSquare(A))
     {
         return false;
@@ -481,12 +738,12 @@ bool inverse(const Matrix& A, Matrix& AInv)
     // In that case the row operations that reduce A to I convert I to A's inverse.
     // Thus, strategy is to reduce [A I] to reduced echelon form.
     int n = A.rows();
-    Matrix I = Matrix::identity(n);
-    Matrix aug = augment(A, I);
+    BasicMatrix<T> I = BasicMatrix<T>::identity(n);
+    BasicMatrix<T> aug = augment(A, I);
     eliminate(aug, partialPivotSelector);
-    if (approxEqual(partition(aug, {0, 0}, {n - 1, n - 1}), I))
+    if (approxEqual(aug.block(0, 0, n, n), I))
     {
-        AInv = partition(aug, {0, n}, {n - 1, 2 * n - 1});
+        copy(aug.block(0, n, n, n), AInv);
         return true;
     }
     else
@@ -495,10 +752,56 @@ bool inverse(const Matrix& A, Matrix& AInv)
     }
 }
 
-float det(const Matrix& A)
+template <typename T>
+T det(const BasicMatrix<T>& A)
 {
     // TODO
-    return 0.0F;
-}
+    return T(0);
+}
+
+#define LA_INSTANTIATE_MATRIX(T)                                              \
+    template class BasicMatrix<T>;                                            \
+    template bool operator==(const BasicMatrix<T>&, const BasicMatrix<T>&);   \
+    template bool operator!=(const BasicMatrix<T>&, const BasicMatrix<T>&);   \
+    template BasicMatrix<T> operator+(const BasicMatrix<T>&,                  \
+                                      const BasicMatrix<T>&);                 \
+    template BasicMatrix<T> operator-(const BasicMatrix<T>&,                  \
+                                      const BasicMatrix<T>&);                 \
+    template BasicMatrix<T> operator*(const BasicMatrix<T>&, T);              \
+    template BasicMatrix<T> operator*(T, const BasicMatrix<T>&);              \
+    template BasicVector<T> operator*(const BasicMatrix<T>&,                  \
+                                      const BasicVector<T>&);                 \
+    template BasicMatrix<T> operator*(const BasicMatrix<T>&,                  \
+                                      const BasicMatrix<T>&);                 \
+    template std::ostream& operator<<(std::ostream&, const BasicMatrix<T>&);  \
+    template BasicMatrix<T> round(const BasicMatrix<T>&, RealType<T>);        \
+    template bool approxEqual(const BasicMatrix<T>&, const BasicMatrix<T>&,   \
+                              RealType<T>);                                   \
+    template BasicMatrix<T> augment(const BasicMatrix<T>&,                    \
+                                    const BasicVector<T>&);                   \
+    template BasicMatrix<T> augment(const BasicMatrix<T>&,                    \
+                                    const BasicMatrix<T>&);                   \
+    template BasicMatrix<T> deleteRow(const BasicMatrix<T>&, int);            \
+    template BasicMatrix<T> deleteCol(const BasicMatrix<T>&, int);            \
+    template BasicMatrix<T> deleteRowAndCol(const BasicMatrix<T>&, int, int); \
+    template BasicMatrix<T> partition(const BasicMatrix<T>&,                  \
+                                      std::pair<int, int>,                    \
+                                      std::pair<int, int>);                   \
+    template bool isSquare(const BasicMatrix<T>&);                            \
+    template bool isInvertible(const BasicMatrix<T>&);                        \
+    template BasicMatrix<T> pow(const BasicMatrix<T>&, unsigned int);         \
+    template BasicMatrix<T> transpose(const BasicMatrix<T>&);                 \
+    template void transpose(const BasicConstMatrixView<T>&,                   \
+                            const BasicMatrixView<T>&, int);                  \
+    template void transposeInPlace(const BasicMatrixView<T>&);                \
+    template bool inverse(const BasicMatrix<T>&, BasicMatrix<T>&);            \
+    template T det(const BasicMatrix<T>&);
+
+LA_INSTANTIATE_MATRIX(float)
+LA_INSTANTIATE_MATRIX(double)
+LA_INSTANTIATE_MATRIX(std::complex<float>)
+LA_INSTANTIATE_MATRIX(std::complex<double>)
+
+#undef LA_INSTANTIATE_MATRIX
 
 }  // namespace la
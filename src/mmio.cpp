@@ -0,0 +1,652 @@
+#include "inc/mmio.h"
+#include "inc/format.h"
+#include "inc/mapped.h"
+#include <algorithm>  // min(), max()
+#include <cctype>
+#include <charconv>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace la
+{
+
+namespace
+{
+
+// Files are split into chunks of at least this size for parsing.
+const std::size_t MIN_CHUNK_BYTES = 1 << 20;
+
+// Output is handed to the file in pieces of about this size.
+const std::size_t FLUSH_BYTES = 1 << 16;
+
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* lineEnd(const char* p, const char* last)
+{
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', last - p));
+    return eol != nullptr ? eol : last;
+}
+
+// True for lines holding data, rather than blank or comment lines.
+bool isDataLine(const char* p, const char* eol)
+{
+    while (p < eol && isBlank(*p))
+    {
+        ++p;
+    }
+    return p < eol && *p != '%';
+}
+
+/**
+ * Parses the number starting after any blanks at p, stopping before eol.
+ * Returns the end of the number, or null if there is none.
+ */
+template <typename X>
+const char* parseField(const char* p, const char* eol, X& x)
+{
+    while (p < eol && isBlank(*p))
+    {
+        ++p;
+    }
+    if (p < eol && *p == '+')
+    {
+        ++p;
+    }
+    std::from_chars_result r = std::from_chars(p, eol, x);
+    return r.ec == std::errc() ? r.ptr : nullptr;
+}
+
+std::string lower(std::string s)
+{
+    for (char& c : s)
+    {
+        c = std::tolower(static_cast<unsigned char>(c));
+    }
+    return s;
+}
+
+/**
+ * Parses the banner, comments and size line at the start of [p, last).
+ * On success, advances p to the first entry line.
+ */
+bool parseHeader(const char*& p, const char* last, MatrixMarketHeader& h)
+{
+    const char* eol = lineEnd(p, last);
+    std::vector<std::string> words;
+    for (const char* q = p; q < eol; )
+    {
+        while (q < eol && isBlank(*q))
+        {
+            ++q;
+        }
+        const char* w = q;
+        while (q < eol && !isBlank(*q))
+        {
+            ++q;
+        }
+        if (q > w)
+        {
+            words.push_back(lower(std::string(w, q)));
+        }
+    }
+    if (words.size() != 5 || words[0] != "%%matrixmarket"
+        || words[1] != "matrix")
+    {
+        return false;
+    }
+
+    if (words[2] != "coordinate" && words[2] != "array")
+    {
+        return false;
+    }
+    h.coordinate = (words[2] == "coordinate");
+    if (words[3] == "real" || words[3] == "double")
+    {
+        h.field = MatrixMarketField::Real;
+    }
+    else if (words[3] == "integer")
+    {
+        h.field = MatrixMarketField::Integer;
+    }
+    else if (words[3] == "complex")
+    {
+        h.field = MatrixMarketField::Complex;
+    }
+    else if (words[3] == "pattern" && h.coordinate)
+    {
+        h.field = MatrixMarketField::Pattern;
+    }
+    else
+    {
+        return false;
+    }
+    if (words[4] == "general")
+    {
+        h.symmetry = MatrixMarketSymmetry::General;
+    }
+    else if (words[4] == "symmetric")
+    {
+        h.symmetry = MatrixMarketSymmetry::Symmetric;
+    }
+    else if (words[4] == "skew-symmetric")
+    {
+        h.symmetry = MatrixMarketSymmetry::SkewSymmetric;
+    }
+    else if (words[4] == "hermitian")
+    {
+        h.symmetry = MatrixMarketSymmetry::Hermitian;
+    }
+    else
+    {
+        return false;
+    }
+
+    // Skip comments to the size line.
+    do
+    {
+        p = (eol < last) ? eol + 1 : last;
+        eol = lineEnd(p, last);
+    } while (p < last && !isDataLine(p, eol));
+    const char* q = parseField(p, eol, h.rows);
+    q = q ? parseField(q, eol, h.cols) : nullptr;
+    if (q && h.coordinate)
+    {
+        q = parseField(q, eol, h.entries);
+    }
+    if (q == nullptr || h.rows < 0 || h.cols < 0
+        || (h.symmetry != MatrixMarketSymmetry::General && h.rows != h.cols))
+    {
+        return false;
+    }
+    if (!h.coordinate)
+    {
+        long long n = h.cols;
+        switch (h.symmetry)
+        {
+        case MatrixMarketSymmetry::General:
+            h.entries = static_cast<long long>(h.rows) * h.cols;
+            break;
+        case MatrixMarketSymmetry::SkewSymmetric:
+            h.entries = n * (n - 1) / 2;
+            break;
+        default:
+            h.entries = n * (n + 1) / 2;
+        }
+    }
+    p = (eol < last) ? eol + 1 : last;
+    return h.entries >= 0;
+}
+
+// First row of column j that an array file stores.
+int firstStoredRow(const MatrixMarketHeader& h, int j)
+{
+    switch (h.symmetry)
+    {
+    case MatrixMarketSymmetry::General:
+        return 0;
+    case MatrixMarketSymmetry::SkewSymmetric:
+        return j + 1;
+    default:
+        return j;
+    }
+}
+
+/**
+ * Parses the entry lines in [first, last), the k-th entry of the file
+ * being the first, and passes each to store(k, i, j, re, im) with
+ * zero-based indices. Returns false on a malformed line.
+ */
+template <typename R, typename Store>
+bool parseChunk(const char* first, const char* last,
+                const MatrixMarketHeader& h, long long k, Store& store)
+{
+    // Position of entry k in an array file.
+    int i = 0, j = 0;
+    if (!h.coordinate)
+    {
+        long long rest = k;
+        while (j < h.cols && rest >= h.rows - firstStoredRow(h, j))
+        {
+            rest -= std::max(h.rows - firstStoredRow(h, j), 0);
+            ++j;
+        }
+        i = firstStoredRow(h, j) + rest;
+    }
+
+    for (const char* p = first; p < last; )
+    {
+        const char* eol = lineEnd(p, last);
+        if (!isDataLine(p, eol))
+        {
+            p = eol + 1;
+            continue;
+        }
+        if (h.coordinate)
+        {
+            p = parseField(p, eol, i);
+            p = p ? parseField(p, eol, j) : nullptr;
+            if (p == nullptr || i < 1 || i > h.rows || j < 1 || j > h.cols)
+            {
+                return false;
+            }
+            --i;
+            --j;
+        }
+        R re = R(1), im = R(0);
+        if (h.field != MatrixMarketField::Pattern)
+        {
+            p = parseField(p, eol, re);
+        }
+        if (p && h.field == MatrixMarketField::Complex)
+        {
+            p = parseField(p, eol, im);
+        }
+        if (p == nullptr || k >= h.entries)
+        {
+            return false;
+        }
+        while (p < eol && isBlank(*p))
+        {
+            ++p;
+        }
+        if (p != eol)
+        {
+            return false;  // trailing text
+        }
+        store(k, i, j, re, im);
+        ++k;
+
+        if (!h.coordinate)
+        {
+            ++i;
+            while (j < h.cols && i >= h.rows)
+            {
+                ++j;
+                i = firstStoredRow(h, j);
+            }
+        }
+        p = eol + 1;
+    }
+    return true;
+}
+
+// Runs f(t) for t in [0, n), each call on its own thread.
+template <typename F>
+void parallelFor(int n, F f)
+{
+    std::vector<std::thread> workers;
+    for (int t = 1; t < n; ++t)
+    {
+        workers.emplace_back(f, t);
+    }
+    f(0);
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+}
+
+/**
+ * Parses the entry lines in [first, last) in parallel. The text is split
+ * into chunks at line breaks; a first pass counts each chunk's entries so
+ * every chunk knows the index of its first entry, and a second parses.
+ * Returns false unless every line parses and the count matches h.
+ */
+template <typename R, typename Store>
+bool parseEntries(const char* first, const char* last,
+                  const MatrixMarketHeader& h, int threads, Store store)
+{
+    std::size_t bytes = last - first;
+    if (threads <= 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    int chunks = static_cast<int>(
+        std::min<std::size_t>(threads, bytes / MIN_CHUNK_BYTES + 1));
+
+    std::vector<const char*> bounds(chunks + 1, last);
+    bounds[0] = first;
+    for (int t = 1; t < chunks; ++t)
+    {
+        const char* p = std::max(first + bytes / chunks * t, bounds[t - 1]);
+        bounds[t] = (p < last) ? std::min(lineEnd(p, last) + 1, last) : last;
+    }
+
+    std::vector<long long> count(chunks + 1, 0);
+    parallelFor(chunks, [&](int t)
+    {
+        for (const char* p = bounds[t]; p < bounds[t + 1]; )
+        {
+            const char* eol = lineEnd(p, bounds[t + 1]);
+            count[t + 1] += isDataLine(p, eol);
+            p = eol + 1;
+        }
+    });
+    for (int t = 0; t < chunks; ++t)
+    {
+        count[t + 1] += count[t];
+    }
+    if (count[chunks] != h.entries)
+    {
+        return false;
+    }
+
+    std::vector<char> ok(chunks);
+    parallelFor(chunks, [&](int t)
+    {
+        ok[t] = parseChunk<R>(bounds[t], bounds[t + 1], h, count[t], store);
+    });
+    return std::count(ok.begin(), ok.end(), 0) == 0;
+}
+
+template <typename R>
+void setScalar(R& x, R re, R)
+{
+    x = re;
+}
+
+template <typename R>
+void setScalar(std::complex<R>& x, R re, R im)
+{
+    x = {re, im};
+}
+
+// The entry (j, i) implied by the stored entry (i, j).
+template <typename R>
+R mirror(R x, MatrixMarketSymmetry s)
+{
+    return (s == MatrixMarketSymmetry::SkewSymmetric) ? -x : x;
+}
+
+template <typename R>
+std::complex<R> mirror(std::complex<R> x, MatrixMarketSymmetry s)
+{
+    switch (s)
+    {
+    case MatrixMarketSymmetry::SkewSymmetric:
+        return -x;
+    case MatrixMarketSymmetry::Hermitian:
+        return std::conj(x);
+    default:
+        return x;
+    }
+}
+
+/**
+ * Appends the text of x to out as Matrix Market fields: the value, or the
+ * real and imaginary parts separated by a space.
+ */
+template <typename R>
+void appendFields(std::string& out, R x)
+{
+    char s[MAX_SCALAR_CHARS];
+    out.append(s, formatScalar(s, s + MAX_SCALAR_CHARS, x));
+}
+
+template <typename R>
+void appendFields(std::string& out, std::complex<R> x)
+{
+    appendFields(out, x.real());
+    out += ' ';
+    appendFields(out, x.imag());
+}
+
+void appendInt(std::string& out, long long x)
+{
+    char s[24];
+    out.append(s, std::to_chars(s, s + sizeof(s), x).ptr);
+}
+
+}  // namespace
+
+/**
+ * Reads the banner and size line of the Matrix Market file at path.
+ * Returns false if the file cannot be read or has no valid header.
+ */
+bool readMatrixMarketHeader(const std::string& path, MatrixMarketHeader& h)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+    const char* p = file.begin();
+    return parseHeader(p, file.end(), h);
+}
+
+/**
+ * Reads the Matrix Market file at path into A, which must have the shape
+ * given by its header (see readMatrixMarketHeader()). Entries are parsed
+ * by the given number of threads, by default one per core; files smaller
+ * than a few megabytes are parsed by fewer. Repeated coordinate entries
+ * are summed. Returns false if the file cannot be read, does not match A,
+ * or is malformed, in which case A's contents are unspecified.
+ */
+template <typename T>
+bool readMatrixMarket(const std::string& path, const BasicMatrixView<T>& A,
+                      int threads)
+{
+    using R = RealType<T>;
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+    file.adviseSequential();
+    MatrixMarketHeader h;
+    const char* p = file.begin();
+    if (!parseHeader(p, file.end(), h) || h.rows != A.rows()
+        || h.cols != A.cols()
+        || (h.field == MatrixMarketField::Complex
+            && std::is_same<T, R>::value))
+    {
+        return false;
+    }
+
+    if (h.coordinate)
+    {
+        // Triplets are gathered in parallel and added up in order.
+        fill(A, T(0));
+        std::vector<int> rows(h.entries), cols(h.entries);
+        std::vector<T> vals(h.entries);
+        auto store = [&](long long k, int i, int j, R re, R im)
+        {
+            rows[k] = i;
+            cols[k] = j;
+            setScalar(vals[k], re, im);
+        };
+        if (!parseEntries<R>(p, file.end(), h, threads, store))
+        {
+            return false;
+        }
+        for (long long k = 0; k < h.entries; ++k)
+        {
+            A(rows[k], cols[k]) += vals[k];
+        }
+    }
+    else
+    {
+        // Each array entry has its own place in A.
+        auto store = [&](long long, int i, int j, R re, R im)
+        {
+            setScalar(A(i, j), re, im);
+        };
+        if (!parseEntries<R>(p, file.end(), h, threads, store))
+        {
+            return false;
+        }
+    }
+
+    if (h.symmetry != MatrixMarketSymmetry::General)
+    {
+        for (int j = 0; j < A.cols(); ++j)
+        {
+            if (h.symmetry == MatrixMarketSymmetry::SkewSymmetric)
+            {
+                A(j, j) = T(0);
+            }
+            for (int i = j + 1; i < A.rows(); ++i)
+            {
+                A(j, i) = mirror(A(i, j), h.symmetry);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the real Matrix Market file at path into A. Array files keep only
+ * their nonzero entries. Returns false if the file cannot be read or is
+ * malformed.
+ */
+bool readMatrixMarket(const std::string& path, SparseMatrix& A, int threads)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+    file.adviseSequential();
+    MatrixMarketHeader h;
+    const char* p = file.begin();
+    if (!parseHeader(p, file.end(), h)
+        || h.field == MatrixMarketField::Complex)
+    {
+        return false;
+    }
+    std::vector<int> rows(h.entries), cols(h.entries);
+    std::vector<float> vals(h.entries);
+    auto store = [&](long long k, int i, int j, float re, float)
+    {
+        rows[k] = i;
+        cols[k] = j;
+        vals[k] = re;
+    };
+    if (!parseEntries<float>(p, file.end(), h, threads, store))
+    {
+        return false;
+    }
+
+    std::size_t stored = 0;
+    for (long long k = 0; k < h.entries; ++k)
+    {
+        if (h.coordinate || vals[k] != 0.0F)
+        {
+            rows[stored] = rows[k];
+            cols[stored] = cols[k];
+            vals[stored] = vals[k];
+            ++stored;
+        }
+    }
+    rows.resize(stored);
+    cols.resize(stored);
+    vals.resize(stored);
+    if (h.symmetry != MatrixMarketSymmetry::General)
+    {
+        for (std::size_t k = 0; k < stored; ++k)
+        {
+            if (rows[k] != cols[k])
+            {
+                rows.push_back(cols[k]);
+                cols.push_back(rows[k]);
+                vals.push_back(mirror(vals[k], h.symmetry));
+            }
+        }
+    }
+    A = SparseMatrix::fromTriplets(h.rows, h.cols, rows, cols, vals);
+    return true;
+}
+
+/**
+ * Writes A to path as a general Matrix Market array file, each entry in
+ * its shortest round-trip form. Returns false if the file cannot be
+ * written.
+ */
+template <typename T>
+bool writeMatrixMarket(const std::string& path,
+                       const BasicConstMatrixView<T>& A)
+{
+    std::ofstream out(path, std::ios::binary);
+    std::string buf = "%%MatrixMarket matrix array ";
+    buf += std::is_same<T, RealType<T>>::value ? "real" : "complex";
+    buf += " general\n";
+    appendInt(buf, A.rows());
+    buf += ' ';
+    appendInt(buf, A.cols());
+    buf += '\n';
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int i = 0; i < A.rows(); ++i)
+        {
+            appendFields(buf, A(i, j));
+            buf += '\n';
+            if (buf.size() >= FLUSH_BYTES)
+            {
+                out.write(buf.data(), buf.size());
+                buf.clear();
+            }
+        }
+    }
+    out.write(buf.data(), buf.size());
+    return static_cast<bool>(out);
+}
+
+/**
+ * Writes A to path as a general real Matrix Market coordinate file.
+ * Returns false if the file cannot be written.
+ */
+bool writeMatrixMarket(const std::string& path, const SparseMatrix& A)
+{
+    std::ofstream out(path, std::ios::binary);
+    std::string buf = "%%MatrixMarket matrix coordinate real general\n";
+    appendInt(buf, A.rows());
+    buf += ' ';
+    appendInt(buf, A.cols());
+    buf += ' ';
+    appendInt(buf, A.nonzeros());
+    buf += '\n';
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+    const std::vector<float>& vals = A.values();
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int k = cp[j]; k < cp[j + 1]; ++k)
+        {
+            appendInt(buf, ri[k] + 1);
+            buf += ' ';
+            appendInt(buf, j + 1);
+            buf += ' ';
+            appendFields(buf, vals[k]);
+            buf += '\n';
+            if (buf.size() >= FLUSH_BYTES)
+            {
+                out.write(buf.data(), buf.size());
+                buf.clear();
+            }
+        }
+    }
+    out.write(buf.data(), buf.size());
+    return static_cast<bool>(out);
+}
+
+#define LA_INSTANTIATE_MMIO(T)                                                \
+    template bool readMatrixMarket(const std::string&,                        \
+                                   const BasicMatrixView<T>&, int);           \
+    template bool writeMatrixMarket(const std::string&,                       \
+                                    const BasicConstMatrixView<T>&);
+
+LA_INSTANTIATE_MMIO(float)
+LA_INSTANTIATE_MMIO(double)
+LA_INSTANTIATE_MMIO(std::complex<float>)
+LA_INSTANTIATE_MMIO(std::complex<double>)
+
+#undef LA_INSTANTIATE_MMIO
+
+}  // namespace la
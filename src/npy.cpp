@@ -0,0 +1,765 @@
+#include "inc/npy.h"
+#include "inc/matrix.h"
+#include <algorithm>  // find()
+#include <cassert>
+#include <climits>
+#include <complex>
+#include <cstring>
+#include <fstream>
+
+namespace la
+{
+
+namespace
+{
+
+const char NPY_MAGIC[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+// The header dictionary is padded so the data starts on this boundary.
+const std::size_t NPY_ALIGNMENT = 64;
+
+const std::uint32_t LOCAL_SIGNATURE = 0x04034b50;
+const std::uint32_t CENTRAL_SIGNATURE = 0x02014b50;
+const std::uint32_t END_SIGNATURE = 0x06054b50;
+const std::uint32_t ZIP64_END_SIGNATURE = 0x06064b50;
+const std::uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+const std::uint16_t ZIP64_EXTRA_ID = 0x0001;
+const std::uint32_t ZIP_LIMIT = 0xFFFFFFFF;  // larger values need zip64
+
+// Fixed-size parts of the zip records.
+const std::size_t LOCAL_SIZE = 30;
+const std::size_t CENTRAL_SIZE = 46;
+const std::size_t END_SIZE = 22;
+const std::size_t ZIP64_END_SIZE = 56;
+const std::size_t ZIP64_LOCATOR_SIZE = 20;
+
+// 1 January 1980, the earliest DOS date.
+const std::uint16_t DOS_DATE = 0x0021;
+
+std::size_t entrySize(BinaryType t)
+{
+    switch (t)
+    {
+    case BinaryType::Float32:
+        return 4;
+    case BinaryType::Float64:
+    case BinaryType::Complex64:
+        return 8;
+    default:
+        return 16;
+    }
+}
+
+const char* descr(BinaryType t)
+{
+    switch (t)
+    {
+    case BinaryType::Float32:
+        return "<f4";
+    case BinaryType::Float64:
+        return "<f8";
+    case BinaryType::Complex64:
+        return "<c8";
+    default:
+        return "<c16";
+    }
+}
+
+// The unsigned little-endian integer of N bytes at p.
+template <typename U, std::size_t N = sizeof(U)>
+U load(const char* p)
+{
+    U x = 0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        x |= static_cast<U>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return x;
+}
+
+// Appends x to s as a little-endian integer of sizeof(U) bytes.
+template <typename U>
+void store(std::string& s, U x)
+{
+    for (std::size_t i = 0; i < sizeof(U); ++i)
+    {
+        s += static_cast<char>((x >> (8 * i)) & 0xFF);
+    }
+}
+
+// CRC-32 of n bytes, as used by zip, continuing from crc.
+std::uint32_t crc32(const void* p, std::size_t n, std::uint32_t crc = 0)
+{
+    static const struct Table
+    {
+        std::uint32_t t[256];
+
+        Table()
+        {
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                }
+                t[i] = c;
+            }
+        }
+    } table;
+
+    const unsigned char* b = static_cast<const unsigned char*>(p);
+    crc = ~crc;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        crc = table.t[(crc ^ b[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+const char* skipSpace(const char* p, const char* last)
+{
+    while (p < last && (*p == ' ' || *p == '\t' || *p == '\n'))
+    {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * Finds the value of key in the header dictionary [first, last).
+ * Returns a pointer to the value, or null if the key is missing.
+ */
+const char* findValue(const char* first, const char* last, const char* key)
+{
+    std::size_t n = std::strlen(key);
+    for (const char* p = first; p + n + 2 <= last; ++p)
+    {
+        if ((*p == '\'' || *p == '"') && p[n + 1] == *p
+            && std::memcmp(p + 1, key, n) == 0)
+        {
+            p = skipSpace(p + n + 2, last);
+            if (p == last || *p != ':')
+            {
+                return nullptr;
+            }
+            return skipSpace(p + 1, last);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Parses the header dictionary [first, last), such as
+ * {'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }
+ */
+bool parseDictionary(const char* first, const char* last, NpyHeader& h)
+{
+    const char* p = findValue(first, last, "descr");
+    if (p == nullptr || (*p != '\'' && *p != '"'))
+    {
+        return false;
+    }
+    const char* q = std::find(p + 1, last, *p);
+    std::string type(p + 1, q);
+    if (type == "<f4")
+    {
+        h.dtype = BinaryType::Float32;
+    }
+    else if (type == "<f8")
+    {
+        h.dtype = BinaryType::Float64;
+    }
+    else if (type == "<c8")
+    {
+        h.dtype = BinaryType::Complex64;
+    }
+    else if (type == "<c16")
+    {
+        h.dtype = BinaryType::Complex128;
+    }
+    else
+    {
+        return false;
+    }
+
+    p = findValue(first, last, "fortran_order");
+    if (p != nullptr && last - p >= 4 && std::memcmp(p, "True", 4) == 0)
+    {
+        h.fortranOrder = true;
+    }
+    else if (p != nullptr && last - p >= 5
+             && std::memcmp(p, "False", 5) == 0)
+    {
+        h.fortranOrder = false;
+    }
+    else
+    {
+        return false;
+    }
+
+    p = findValue(first, last, "shape");
+    if (p == nullptr || *p != '(')
+    {
+        return false;
+    }
+    long long dims[2] = {1, 1};
+    int ndim = 0;
+    p = skipSpace(p + 1, last);
+    while (p < last && *p != ')')
+    {
+        if (ndim == 2 || *p < '0' || *p > '9')
+        {
+            return false;
+        }
+        long long d = 0;
+        for (; p < last && *p >= '0' && *p <= '9'; ++p)
+        {
+            d = 10 * d + (*p - '0');
+            if (d > INT_MAX)
+            {
+                return false;
+            }
+        }
+        dims[ndim++] = d;
+        p = skipSpace(p, last);
+        if (p < last && *p == ',')
+        {
+            p = skipSpace(p + 1, last);
+        }
+    }
+    if (p == last)
+    {
+        return false;
+    }
+    h.rows = static_cast<int>(dims[0]);
+    h.cols = static_cast<int>(dims[1]);
+    return true;
+}
+
+template <typename S, typename R>
+bool convertScalar(S s, R& x)
+{
+    x = static_cast<R>(s);
+    return true;
+}
+
+template <typename S, typename R>
+bool convertScalar(S s, std::complex<R>& x)
+{
+    x = {static_cast<R>(s), R(0)};
+    return true;
+}
+
+template <typename S, typename R>
+bool convertScalar(std::complex<S> s, std::complex<R>& x)
+{
+    x = {static_cast<R>(s.real()), static_cast<R>(s.imag())};
+    return true;
+}
+
+// Complex entries do not fit a real matrix.
+template <typename S, typename R>
+bool convertScalar(std::complex<S>, R&)
+{
+    return false;
+}
+
+/**
+ * Reads the entries of type S at p, which need not be aligned, into A,
+ * converting them to T.
+ */
+template <typename S, typename T>
+bool convertEntries(const char* p, bool fortranOrder,
+                    const BasicMatrixView<T>& A)
+{
+    std::size_t m = A.rows();
+    std::size_t n = A.cols();
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            std::size_t k = fortranOrder ? i + j * m : i * n + j;
+            S s;
+            std::memcpy(&s, p + k * sizeof(S), sizeof(S));
+            if (!convertScalar(s, A(i, j)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the .npy file held in the size bytes at data into A, which must
+ * have the shape of the array. Column-major arrays of T are copied
+ * directly and row-major arrays are transposed into place; other arrays
+ * are converted entry by entry.
+ */
+template <typename T>
+bool readNpyData(const char* data, std::size_t size,
+                 const BasicMatrixView<T>& A)
+{
+    NpyHeader h;
+    if (!parseNpyHeader(data, size, h) || h.rows != A.rows()
+        || h.cols != A.cols())
+    {
+        return false;
+    }
+    if (h.rows == 0 || h.cols == 0)
+    {
+        return true;
+    }
+
+    const char* p = data + h.dataOffset;
+    if (h.dtype == BinaryTypeOf<T>::value
+        && reinterpret_cast<std::uintptr_t>(p) % alignof(T) == 0)
+    {
+        const T* q = reinterpret_cast<const T*>(p);
+        if (h.fortranOrder)
+        {
+            copy(BasicConstMatrixView<T>(q, h.rows, h.cols, h.rows), A);
+        }
+        else
+        {
+            transpose(BasicConstMatrixView<T>(q, h.cols, h.rows, h.cols), A);
+        }
+        return true;
+    }
+
+    switch (h.dtype)
+    {
+    case BinaryType::Float32:
+        return convertEntries<float>(p, h.fortranOrder, A);
+    case BinaryType::Float64:
+        return convertEntries<double>(p, h.fortranOrder, A);
+    case BinaryType::Complex64:
+        return convertEntries<std::complex<float>>(p, h.fortranOrder, A);
+    default:
+        return convertEntries<std::complex<double>>(p, h.fortranOrder, A);
+    }
+}
+
+/**
+ * The header of a column-major .npy file holding an m x n matrix of T,
+ * padded so the entries that follow it are aligned.
+ */
+template <typename T>
+std::string npyHeader(int m, int n)
+{
+    std::string dict = "{'descr': '";
+    dict += descr(BinaryTypeOf<T>::value);
+    dict += "', 'fortran_order': True, 'shape': (";
+    dict += std::to_string(m) + ", " + std::to_string(n) + "), }";
+
+    // Version 1.0 stores the header length in 2 bytes, later ones in 4.
+    bool wide = dict.size() + 1 + 10 + NPY_ALIGNMENT > 0xFFFF;
+    std::size_t prefix = wide ? 12 : 10;
+    std::size_t total = prefix + dict.size() + 1;
+    total = (total + NPY_ALIGNMENT - 1) / NPY_ALIGNMENT * NPY_ALIGNMENT;
+    dict.append(total - prefix - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::string s(NPY_MAGIC, sizeof(NPY_MAGIC));
+    s += static_cast<char>(wide ? 2 : 1);
+    s += '\0';
+    if (wide)
+    {
+        store(s, static_cast<std::uint32_t>(dict.size()));
+    }
+    else
+    {
+        store(s, static_cast<std::uint16_t>(dict.size()));
+    }
+    return s + dict;
+}
+
+/**
+ * Writes the entries of A to out in column-major order, continuing the
+ * CRC-32 crc over them. Returns the updated CRC-32.
+ */
+template <typename T>
+std::uint32_t writeEntries(std::ostream& out, const BasicConstMatrixView<T>& A,
+                           std::uint32_t crc = 0)
+{
+    std::size_t bytes = A.rows() * sizeof(T);
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        const char* p = reinterpret_cast<const char*>(A.data() + j * A.ld());
+        out.write(p, bytes);
+        crc = crc32(p, bytes, crc);
+    }
+    return crc;
+}
+
+}  // namespace
+
+/**
+ * Parses the header of the .npy file held in the size bytes at data.
+ * Returns false if the header is malformed, describes an array of an
+ * unsupported type or of more than 2 dimensions, or if the entries do not
+ * fit in the size bytes.
+ */
+bool parseNpyHeader(const char* data, std::size_t size, NpyHeader& h)
+{
+    if (size < 10 || std::memcmp(data, NPY_MAGIC, sizeof(NPY_MAGIC)) != 0)
+    {
+        return false;
+    }
+    int major = static_cast<unsigned char>(data[6]);
+    std::size_t prefix;
+    std::size_t length;
+    if (major == 1)
+    {
+        prefix = 10;
+        length = load<std::uint16_t>(data + 8);
+    }
+    else if ((major == 2 || major == 3) && size >= 12)
+    {
+        prefix = 12;
+        length = load<std::uint32_t>(data + 8);
+    }
+    else
+    {
+        return false;
+    }
+    if (length > size - prefix
+        || !parseDictionary(data + prefix, data + prefix + length, h))
+    {
+        return false;
+    }
+    h.dataOffset = prefix + length;
+    std::uint64_t bytes = static_cast<std::uint64_t>(h.rows) * h.cols
+                          * entrySize(h.dtype);
+    return bytes <= size - h.dataOffset;
+}
+
+/**
+ * Reads the header of the .npy file at path.
+ * Returns false if the file cannot be read or the header is invalid.
+ */
+bool readNpyHeader(const std::string& path, NpyHeader& h)
+{
+    MappedFile file;
+    return file.open(path) && parseNpyHeader(file.begin(), file.size(), h);
+}
+
+/**
+ * Reads the .npy file at path into A, which must have the shape of the
+ * array: n x 1 for a one-dimensional array and 1 x 1 for a scalar.
+ * Returns false if the file cannot be read, has a different shape, or
+ * holds complex entries and T is real.
+ */
+template <typename T>
+bool readNpy(const std::string& path, const BasicMatrixView<T>& A)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return false;
+    }
+    file.adviseSequential();
+    return readNpyData(file.begin(), file.size(), A);
+}
+
+/**
+ * Writes A to a .npy file at path, in column-major (Fortran) order.
+ * Returns false if the file cannot be written.
+ */
+template <typename T>
+bool writeNpy(const std::string& path, const BasicConstMatrixView<T>& A)
+{
+    std::ofstream out(path, std::ios::binary);
+    std::string header = npyHeader<T>(A.rows(), A.cols());
+    out.write(header.data(), header.size());
+    writeEntries(out, A);
+    return static_cast<bool>(out);
+}
+
+/**
+ * Writes arrays to an uncompressed .npz archive at path, as entries
+ * named names[k] + ".npy". Returns false if the file cannot be written
+ * or the archive would need zip64 extensions.
+ */
+template <typename T>
+bool writeNpz(const std::string& path, const std::vector<std::string>& names,
+              const std::vector<BasicConstMatrixView<T>>& arrays)
+{
+    assert(names.size() == arrays.size());
+    if (names.size() >= 0xFFFF)
+    {
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    std::string central;
+    std::uint64_t offset = 0;
+    for (std::size_t k = 0; k < arrays.size(); ++k)
+    {
+        const BasicConstMatrixView<T>& A = arrays[k];
+        std::string name = names[k] + ".npy";
+        std::string header = npyHeader<T>(A.rows(), A.cols());
+        std::uint64_t size = header.size()
+                             + std::uint64_t(A.rows()) * A.cols() * sizeof(T);
+        if (offset + LOCAL_SIZE + name.size() + size >= ZIP_LIMIT
+            || name.size() > 0xFFFF)
+        {
+            return false;
+        }
+
+        // The local header is rewritten once the CRC-32 is known.
+        std::string local;
+        store(local, LOCAL_SIGNATURE);
+        store<std::uint16_t>(local, 20);  // version needed to extract
+        store<std::uint16_t>(local, 0);   // flags
+        store<std::uint16_t>(local, 0);   // stored, not compressed
+        store<std::uint16_t>(local, 0);   // time
+        store(local, DOS_DATE);
+        std::size_t crcAt = local.size();
+        store<std::uint32_t>(local, 0);
+        store(local, static_cast<std::uint32_t>(size));
+        store(local, static_cast<std::uint32_t>(size));
+        store(local, static_cast<std::uint16_t>(name.size()));
+        store<std::uint16_t>(local, 0);   // extra field length
+        local += name;
+        out.write(local.data(), local.size());
+        out.write(header.data(), header.size());
+        std::uint32_t crc = writeEntries(out, A,
+                                         crc32(header.data(), header.size()));
+        std::string crcBytes;
+        store(crcBytes, crc);
+        local.replace(crcAt, crcBytes.size(), crcBytes);
+        out.seekp(offset + crcAt);
+        out.write(crcBytes.data(), crcBytes.size());
+        out.seekp(0, std::ios::end);
+
+        // The central header repeats the local one up to the name length.
+        store(central, CENTRAL_SIGNATURE);
+        store<std::uint16_t>(central, 20);  // version made by
+        central += local.substr(4, LOCAL_SIZE - 4 - 2);
+        store<std::uint16_t>(central, 0);   // extra field length
+        store<std::uint16_t>(central, 0);   // comment length
+        store<std::uint16_t>(central, 0);   // disk number
+        store<std::uint16_t>(central, 0);   // internal attributes
+        store<std::uint32_t>(central, 0);   // external attributes
+        store(central, static_cast<std::uint32_t>(offset));
+        central += name;
+        offset += local.size() + size;
+    }
+    if (offset + central.size() >= ZIP_LIMIT)
+    {
+        return false;
+    }
+
+    std::string end;
+    store(end, END_SIGNATURE);
+    store<std::uint16_t>(end, 0);  // disk number
+    store<std::uint16_t>(end, 0);  // disk with the central directory
+    store(end, static_cast<std::uint16_t>(arrays.size()));
+    store(end, static_cast<std::uint16_t>(arrays.size()));
+    store(end, static_cast<std::uint32_t>(central.size()));
+    store(end, static_cast<std::uint32_t>(offset));
+    store<std::uint16_t>(end, 0);  // comment length
+    out.write(central.data(), central.size());
+    out.write(end.data(), end.size());
+    return static_cast<bool>(out);
+}
+
+/**
+ * Maps the .npz archive at path and reads its central directory, closing
+ * any archive already open. Returns false if the file cannot be mapped or
+ * is not a zip archive.
+ */
+bool NpzReader::open(const std::string& path)
+{
+    _names.clear();
+    _entries.clear();
+    if (!_file.open(path) || _file.size() < END_SIZE)
+    {
+        _file.close();
+        return false;
+    }
+    const char* base = _file.begin();
+    std::size_t size = _file.size();
+
+    // The end record is last, followed only by a comment of < 64 KiB.
+    std::size_t end = size - END_SIZE;
+    std::size_t stop = (end > 0xFFFF) ? end - 0xFFFF : 0;
+    while (load<std::uint32_t>(base + end) != END_SIGNATURE)
+    {
+        if (end == stop)
+        {
+            _file.close();
+            return false;
+        }
+        --end;
+    }
+    std::uint64_t count = load<std::uint16_t>(base + end + 10);
+    std::uint64_t dirSize = load<std::uint32_t>(base + end + 12);
+    std::uint64_t dirOffset = load<std::uint32_t>(base + end + 16);
+
+    // Archives written with zip64 extensions keep the counts elsewhere.
+    if (end >= ZIP64_LOCATOR_SIZE
+        && load<std::uint32_t>(base + end - ZIP64_LOCATOR_SIZE)
+               == ZIP64_LOCATOR_SIGNATURE)
+    {
+        std::uint64_t at = load<std::uint64_t>(
+            base + end - ZIP64_LOCATOR_SIZE + 8);
+        if (at > size - ZIP64_END_SIZE
+            || load<std::uint32_t>(base + at) != ZIP64_END_SIGNATURE)
+        {
+            _file.close();
+            return false;
+        }
+        count = load<std::uint64_t>(base + at + 32);
+        dirSize = load<std::uint64_t>(base + at + 40);
+        dirOffset = load<std::uint64_t>(base + at + 48);
+    }
+    if (dirOffset > size || dirSize > size - dirOffset)
+    {
+        _file.close();
+        return false;
+    }
+
+    const char* p = base + dirOffset;
+    const char* last = p + dirSize;
+    for (std::uint64_t k = 0; k < count; ++k)
+    {
+        if (last - p < static_cast<std::ptrdiff_t>(CENTRAL_SIZE)
+            || load<std::uint32_t>(p) != CENTRAL_SIGNATURE)
+        {
+            break;
+        }
+        std::uint16_t method = load<std::uint16_t>(p + 10);
+        Entry e;
+        e.crc = load<std::uint32_t>(p + 16);
+        std::uint64_t packed = load<std::uint32_t>(p + 20);
+        std::uint64_t unpacked = load<std::uint32_t>(p + 24);
+        std::size_t nameLength = load<std::uint16_t>(p + 28);
+        std::size_t extraLength = load<std::uint16_t>(p + 30);
+        std::size_t commentLength = load<std::uint16_t>(p + 32);
+        std::uint64_t local = load<std::uint32_t>(p + 42);
+        const char* name = p + CENTRAL_SIZE;
+        const char* extra = name + nameLength;
+        p = extra + extraLength + commentLength;
+        if (p > last)
+        {
+            break;
+        }
+
+        // Fields too large for 4 bytes are in the zip64 extra field.
+        for (const char* q = extra; q + 4 <= extra + extraLength;)
+        {
+            std::uint16_t id = load<std::uint16_t>(q);
+            const char* next = q + 4 + load<std::uint16_t>(q + 2);
+            q += 4;
+            if (id == ZIP64_EXTRA_ID)
+            {
+                for (std::uint64_t* field : {&unpacked, &packed, &local})
+                {
+                    if (*field == ZIP_LIMIT && q + 8 <= next)
+                    {
+                        *field = load<std::uint64_t>(q);
+                        q += 8;
+                    }
+                }
+            }
+            q = next;
+        }
+
+        if (local > size - LOCAL_SIZE
+            || load<std::uint32_t>(base + local) != LOCAL_SIGNATURE)
+        {
+            break;
+        }
+        e.offset = local + LOCAL_SIZE + load<std::uint16_t>(base + local + 26)
+                   + load<std::uint16_t>(base + local + 28);
+        e.size = packed;
+        e.stored = (method == 0 && packed == unpacked);
+        if (e.offset > size || e.size > size - e.offset)
+        {
+            break;
+        }
+        std::string s(name, nameLength);
+        if (s.size() > 4 && s.compare(s.size() - 4, 4, ".npy") == 0)
+        {
+            s.resize(s.size() - 4);
+        }
+        _names.push_back(s);
+        _entries.push_back(e);
+    }
+    if (_entries.size() != count)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmaps the archive, if any, leaving no arrays.
+void NpzReader::close()
+{
+    _file.close();
+    _names.clear();
+    _entries.clear();
+}
+
+const std::vector<std::string>& NpzReader::names() const
+{
+    return _names;
+}
+
+/**
+ * Reads the header of the named array.
+ * Returns false if there is no such array or it cannot be read.
+ */
+bool NpzReader::header(const std::string& name, NpyHeader& h) const
+{
+    const Entry* e = find(name);
+    return e != nullptr && e->stored
+           && parseNpyHeader(_file.begin() + e->offset, e->size, h);
+}
+
+/**
+ * Reads the named array into A, as readNpy() does, after checking its
+ * CRC-32. Returns false if there is no such array, it is compressed or
+ * corrupt, or it cannot be read into A.
+ */
+template <typename T>
+bool NpzReader::read(const std::string& name,
+                     const BasicMatrixView<T>& A) const
+{
+    const Entry* e = find(name);
+    if (e == nullptr || !e->stored)
+    {
+        return false;
+    }
+    const char* data = _file.begin() + e->offset;
+    return crc32(data, e->size) == e->crc && readNpyData(data, e->size, A);
+}
+
+const NpzReader::Entry* NpzReader::find(const std::string& name) const
+{
+    auto it = std::find(_names.begin(), _names.end(), name);
+    return (it == _names.end()) ? nullptr
+                                : &_entries[it - _names.begin()];
+}
+
+#define LA_INSTANTIATE_NPY(T)                                                 \
+    template bool readNpy(const std::string&, const BasicMatrixView<T>&);     \
+    template bool writeNpy(const std::string&,                                \
+                           const BasicConstMatrixView<T>&);                   \
+    template bool writeNpz(const std::string&,                                \
+                           const std::vector<std::string>&,                   \
+                           const std::vector<BasicConstMatrixView<T>>&);      \
+    template bool NpzReader::read(const std::string&,                         \
+                                  const BasicMatrixView<T>&) const;
+
+LA_INSTANTIATE_NPY(float)
+LA_INSTANTIATE_NPY(double)
+LA_INSTANTIATE_NPY(std::complex<float>)
+LA_INSTANTIATE_NPY(std::complex<double>)
+
+#undef LA_INSTANTIATE_NPY
+
+}  // namespace la
@@ -0,0 +1,136 @@
+#include "inc/pool.h"
+#include "inc/alloc.h"
+#include <cassert>
+#include <complex>
+#include <new>  // bad_alloc
+#include <sys/mman.h>
+
+namespace la
+{
+
+/**
+ * Creates an empty pool for up to capacity vectors of the given length.
+ * Each vector is padded to the leading dimension a Matrix with that many
+ * rows would have. Throws std::bad_alloc if the address space cannot be
+ * reserved.
+ */
+template <typename T>
+BasicVectorPool<T>::BasicVectorPool(int length, int capacity)
+: _p{nullptr},
+  _length{length},
+  _ld{leadingDimension(length, sizeof(T))},
+  _capacity{capacity},
+  _bytes{std::size_t(_ld) * capacity * sizeof(T)},
+  _count{0}
+{
+    assert(length > 0 && capacity > 0);
+    // MAP_NORESERVE: pages are committed as vectors are written, not now.
+    void* p = ::mmap(nullptr, _bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    _p = static_cast<T*>(p);
+}
+
+template <typename T>
+BasicVectorPool<T>::~BasicVectorPool()
+{
+    ::munmap(_p, _bytes);
+}
+
+/**
+ * Appends a copy of v, which must have length() entries. Safe to call
+ * from several threads at once. Returns the index of the new vector, or
+ * -1 if the pool is full.
+ */
+template <typename T>
+int BasicVectorPool<T>::append(const BasicConstVectorView<T>& v)
+{
+    assert(v.size() == _length);
+    int i = claim();
+    if (i >= 0)
+    {
+        copy(v, (*this)[i]);
+    }
+    return i;
+}
+
+/**
+ * Adds count consecutive vectors, with unspecified entries, for the
+ * caller to fill in place. Safe to call from several threads at once.
+ * Returns the index of the first, or -1 if fewer than count are left.
+ */
+template <typename T>
+int BasicVectorPool<T>::claim(int count)
+{
+    assert(count > 0);
+    int n = _count.load(std::memory_order_relaxed);
+    do
+    {
+        if (n > _capacity - count)
+        {
+            return -1;
+        }
+    }
+    while (!_count.compare_exchange_weak(n, n + count,
+                                         std::memory_order_relaxed));
+    return n;
+}
+
+/**
+ * Removes every vector and returns the memory they used to the system,
+ * keeping the reservation. Not safe while other threads use the pool.
+ */
+template <typename T>
+void BasicVectorPool<T>::clear()
+{
+    ::madvise(_p, _bytes, MADV_DONTNEED);
+    _count.store(0, std::memory_order_relaxed);
+}
+
+// The vector at index i, which must have been claimed.
+template <typename T>
+BasicVectorView<T> BasicVectorPool<T>::operator[](int i) const
+{
+    assert(i >= 0 && i < size());
+    return BasicVectorView<T>(_p + std::size_t(i) * _ld, _length);
+}
+
+// The length() x size() matrix whose columns are the vectors.
+template <typename T>
+BasicMatrixView<T> BasicVectorPool<T>::view() const
+{
+    return BasicMatrixView<T>(_p, _length, size(), _ld);
+}
+
+template <typename T>
+int BasicVectorPool<T>::length() const
+{
+    return _length;
+}
+
+template <typename T>
+int BasicVectorPool<T>::size() const
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+int BasicVectorPool<T>::capacity() const
+{
+    return _capacity;
+}
+
+#define LA_INSTANTIATE_POOL(T)                                                \
+    template class BasicVectorPool<T>;
+
+LA_INSTANTIATE_POOL(float)
+LA_INSTANTIATE_POOL(double)
+LA_INSTANTIATE_POOL(std::complex<float>)
+LA_INSTANTIATE_POOL(std::complex<double>)
+
+#undef LA_INSTANTIATE_POOL
+
+}  // namespace la
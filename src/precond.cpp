@@ -0,0 +1,149 @@
+#include "inc/precond.h"
+#include <cassert>
+
+namespace la
+{
+
+JacobiPreconditioner::JacobiPreconditioner(const Matrix& A)
+: _invDiag(A.rows())
+{
+    assert(isSquare(A));
+    for (int i = 0; i < A.rows(); ++i)
+    {
+        float d = A[i][i];
+        _invDiag[i] = (d != 0.0F) ? 1.0F / d : 1.0F;
+    }
+}
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseMatrix& A)
+: _invDiag(A.rows())
+{
+    assert(A.rows() == A.cols());
+    for (int i = 0; i < A.rows(); ++i)
+    {
+        float d = A.at(i, i);
+        _invDiag[i] = (d != 0.0F) ? 1.0F / d : 1.0F;
+    }
+}
+
+int JacobiPreconditioner::rows() const
+{
+    return _invDiag.size();
+}
+
+int JacobiPreconditioner::cols() const
+{
+    return _invDiag.size();
+}
+
+void JacobiPreconditioner::apply(const Vector& r, Vector& z) const
+{
+    assert(r.size() == _invDiag.size() && z.size() == _invDiag.size());
+    const float* d = _invDiag.begin();
+    const float* rp = r.begin();
+    float* zp = z.begin();
+    for (int i = 0, n = _invDiag.size(); i < n; ++i)
+    {
+        zp[i] = d[i] * rp[i];
+    }
+}
+
+/**
+ * Computes the ILU(0) factors of A. The transpose of A in compressed column
+ * form is A in compressed row form, which suits the row-oriented
+ * (IKJ) elimination.
+ */
+ILU0Preconditioner::ILU0Preconditioner(const SparseMatrix& A)
+: _n{A.rows()},
+  _valid{true}
+{
+    assert(A.rows() == A.cols());
+    SparseMatrix At = transpose(A);
+    _rp = At.colPtr();
+    _ci = At.rowIdx();
+    _lu = At.values();
+    _diag.assign(_n, -1);
+
+    std::vector<int> pos(_n, -1);  // position of column j within current row
+    for (int i = 0; i < _n; ++i)
+    {
+        for (int p = _rp[i]; p < _rp[i + 1]; ++p)
+        {
+            pos[_ci[p]] = p;
+            if (_ci[p] == i)
+            {
+                _diag[i] = p;
+            }
+        }
+        for (int p = _rp[i]; p < _rp[i + 1] && _ci[p] < i; ++p)
+        {
+            int k = _ci[p];
+            _lu[p] /= _lu[_diag[k]];
+            for (int q = _diag[k] + 1; q < _rp[k + 1]; ++q)
+            {
+                int j = pos[_ci[q]];
+                if (j >= 0)
+                {
+                    _lu[j] -= _lu[p] * _lu[q];
+                }
+            }
+        }
+        for (int p = _rp[i]; p < _rp[i + 1]; ++p)
+        {
+            pos[_ci[p]] = -1;
+        }
+        if (_diag[i] < 0 || _lu[_diag[i]] == 0.0F)
+        {
+            _valid = false;
+            _diag[i] = -1;
+            return;
+        }
+    }
+}
+
+bool ILU0Preconditioner::valid() const
+{
+    return _valid;
+}
+
+int ILU0Preconditioner::rows() const
+{
+    return _n;
+}
+
+int ILU0Preconditioner::cols() const
+{
+    return _n;
+}
+
+void ILU0Preconditioner::apply(const Vector& r, Vector& z) const
+{
+    assert(_valid);
+    assert(r.size() == _n && z.size() == _n);
+    const float* rp = r.begin();
+    float* zp = z.begin();
+
+    // Forward substitution with unit lower triangular L.
+    for (int i = 0; i < _n; ++i)
+    {
+        float sum = rp[i];
+        for (int p = _rp[i]; p < _diag[i]; ++p)
+        {
+            sum -= _lu[p] * zp[_ci[p]];
+        }
+        zp[i] = sum;
+    }
+
+    // Back substitution with U.
+    for (int i = _n - 1; i >= 0; --i)
+    {
+        float sum = zp[i];
+        for (int p = _diag[i] + 1; p < _rp[i + 1]; ++p)
+        {
+            sum -= _lu[p] * zp[_ci[p]];
+        }
+        zp[i] = sum / _lu[_diag[i]];
+    }
+}
+
+}  // namespace la
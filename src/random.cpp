@@ -0,0 +1,215 @@
+#include "inc/random.h"
+#include <algorithm>  // max(), min()
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace la
+{
+
+namespace
+{
+
+// Philox4x32 round multipliers and Weyl key increments.
+const std::uint32_t M0 = 0xD2511F53;
+const std::uint32_t M1 = 0xCD9E8D57;
+const std::uint32_t W0 = 0x9E3779B9;
+const std::uint32_t W1 = 0xBB67AE85;
+const int ROUNDS = 10;
+
+const double TWO_PI = 6.283185307179586;
+
+// SplitMix64 finalizer: spreads nearby inputs far apart.
+std::uint64_t mix(std::uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Uniform in [0, 1) from the k-th 32 bits of r (float) or 64 bits (double).
+template <typename R>
+R unit(const Philox::Block& r, int k);
+
+template <>
+float unit<float>(const Philox::Block& r, int k)
+{
+    return (r[k] >> 8) * 0x1p-24F;
+}
+
+template <>
+double unit<double>(const Philox::Block& r, int k)
+{
+    std::uint64_t x = (std::uint64_t(r[2 * k]) << 32) | r[2 * k + 1];
+    return (x >> 11) * 0x1p-53;
+}
+
+template <typename T>
+T uniformScalar(const Philox::Block& r, T lo, T hi)
+{
+    return lo + (hi - lo) * unit<T>(r, 0);
+}
+
+template <typename T>
+std::complex<T> uniformScalar(const Philox::Block& r, std::complex<T> lo,
+                              std::complex<T> hi)
+{
+    return {lo.real() + (hi.real() - lo.real()) * unit<T>(r, 0),
+            lo.imag() + (hi.imag() - lo.imag()) * unit<T>(r, 1)};
+}
+
+// A pair of independent standard normals by the Box-Muller transform.
+template <typename T>
+std::complex<T> normalPair(const Philox::Block& r)
+{
+    T radius = std::sqrt(T(-2) * std::log(T(1) - unit<T>(r, 0)));
+    T angle = T(TWO_PI) * unit<T>(r, 1);
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+template <typename T>
+T normalScalar(const Philox::Block& r, T mean, T stddev)
+{
+    return mean + stddev * normalPair<T>(r).real();
+}
+
+template <typename T>
+std::complex<T> normalScalar(const Philox::Block& r, std::complex<T> mean,
+                             T stddev)
+{
+    return mean + stddev * normalPair<T>(r);
+}
+
+/**
+ * Sets each entry (i, j) of A to entry(r), where r is the block of random
+ * bits for counter (i0 + i, j0 + j), dividing the columns between threads.
+ */
+template <typename T, typename Entry>
+void fillEntries(const BasicMatrixView<T>& A, std::uint64_t seed, int i0,
+                 int j0, int threads, Entry entry)
+{
+    assert(i0 >= 0 && j0 >= 0);
+    if (threads <= 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max(1, std::min(threads, A.cols()));
+    Philox g(seed);
+    auto fillColumns = [&](int t)
+    {
+        int lo = static_cast<long long>(A.cols()) * t / threads;
+        int hi = static_cast<long long>(A.cols()) * (t + 1) / threads;
+        for (int j = lo; j < hi; ++j)
+        {
+            T* c = &A(0, j);
+            for (int i = 0; i < A.rows(); ++i)
+            {
+                c[i] = entry(g({std::uint32_t(i0 + i), std::uint32_t(j0 + j),
+                                0, 0}));
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(fillColumns, t);
+    }
+    fillColumns(0);
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+}
+
+}  // namespace
+
+Philox::Philox(std::uint64_t seed)
+: _key{static_cast<std::uint32_t>(seed),
+       static_cast<std::uint32_t>(seed >> 32)}
+{}
+
+// The 128 random bits for counter.
+Philox::Block Philox::operator()(const Block& counter) const
+{
+    Block c = counter;
+    std::uint32_t k0 = _key[0];
+    std::uint32_t k1 = _key[1];
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        std::uint64_t p0 = std::uint64_t(M0) * c[0];
+        std::uint64_t p1 = std::uint64_t(M1) * c[2];
+        c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0,
+             static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1,
+             static_cast<std::uint32_t>(p0)};
+        k0 += W0;
+        k1 += W1;
+    }
+    return c;
+}
+
+/**
+ * Returns a seed for generators that need not be reproducible, different
+ * on every call, from any thread, and in every run of the program.
+ */
+std::uint64_t randomSeed()
+{
+    static const std::uint64_t base =
+        (std::uint64_t(std::random_device()()) << 32)
+        ^ std::chrono::steady_clock::now().time_since_epoch().count();
+    static std::atomic<std::uint64_t> calls{0};
+    return mix(base + calls.fetch_add(1, std::memory_order_relaxed));
+}
+
+/**
+ * Fills A with entries drawn uniformly from [lo, hi], or for complex
+ * entries from the rectangle with corners lo and hi.
+ */
+template <typename T>
+void fillUniform(const BasicMatrixView<T>& A, std::uint64_t seed,
+                 typename BasicMatrixView<T>::value_type lo,
+                 typename BasicMatrixView<T>::value_type hi,
+                 int i0, int j0, int threads)
+{
+    fillEntries(A, seed, i0, j0, threads, [lo, hi](const Philox::Block& r)
+    {
+        return uniformScalar(r, lo, hi);
+    });
+}
+
+/**
+ * Fills A with normally distributed entries of the given mean and
+ * standard deviation; for complex entries, the real and imaginary parts
+ * each have that standard deviation.
+ */
+template <typename T>
+void fillNormal(const BasicMatrixView<T>& A, std::uint64_t seed,
+                typename BasicMatrixView<T>::value_type mean,
+                RealType<T> stddev, int i0, int j0, int threads)
+{
+    assert(stddev >= 0);
+    fillEntries(A, seed, i0, j0, threads,
+                [mean, stddev](const Philox::Block& r)
+    {
+        return normalScalar(r, mean, stddev);
+    });
+}
+
+#define LA_INSTANTIATE_RANDOM(T)                                              \
+    template void fillUniform(const BasicMatrixView<T>&, std::uint64_t, T, T, \
+                              int, int, int);                                 \
+    template void fillNormal(const BasicMatrixView<T>&, std::uint64_t, T,     \
+                             RealType<T>, int, int, int);
+
+LA_INSTANTIATE_RANDOM(float)
+LA_INSTANTIATE_RANDOM(double)
+LA_INSTANTIATE_RANDOM(std::complex<float>)
+LA_INSTANTIATE_RANDOM(std::complex<double>)
+
+#undef LA_INSTANTIATE_RANDOM
+
+}  // namespace la
@@ -0,0 +1,158 @@
+#include "inc/refine.h"
+#include "inc/gauss.h"
+#include "inc/instrument.h"
+#include <algorithm>  // max()
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace la
+{
+
+namespace
+{
+
+double normInf(const BasicVector<double>& v)
+{
+    double norm = 0.0;
+    for (double entry : v)
+    {
+        norm = std::max(norm, std::abs(entry));
+    }
+    return norm;
+}
+
+}  // namespace
+
+MixedPrecisionSolver::MixedPrecisionSolver(const BasicMatrix<double>& A,
+                                           int maxIter)
+: _A(A),
+  _n{A.rows()},
+  _maxIter{maxIter},
+  _iters{0},
+  _fellBack{false},
+  _doubleOk{true},
+  _normA{0.0},
+  _lu(A.rows(), A.cols())
+{
+    assert(isSquare(A) && maxIter > 0);
+    for (int j = 0; j < _n; ++j)
+    {
+        for (int i = 0; i < _n; ++i)
+        {
+            _lu[j][i] = static_cast<float>(A[j][i]);
+        }
+    }
+    _singleOk = luFactor(_lu, _piv);
+    for (int i = 0; i < _n; ++i)
+    {
+        double rowSum = 0.0;
+        for (int j = 0; j < _n; ++j)
+        {
+            rowSum += std::abs(A[j][i]);
+        }
+        _normA = std::max(_normA, rowSum);
+    }
+}
+
+/**
+ * Solves A x = b. Refinement stops once the normwise backward error
+ * ||b - A x|| / (||A|| ||x|| + ||b||) is at the level of double-precision
+ * roundoff. Returns false if A is singular.
+ */
+bool MixedPrecisionSolver::solve(const BasicVector<double>& b,
+                                 BasicVector<double>& x)
+{
+    LA_PROFILE("MixedPrecisionSolver::solve", 0, 0);
+    assert(b.size() == _n && x.size() == _n);
+    x *= 0.0;
+    _iters = 0;
+    _fellBack = false;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    double tol = std::sqrt(static_cast<double>(_n)) * eps;
+    double normB = normInf(b);
+    BasicVector<double> r(b);
+    Vector d(_n);
+    double prevCorrection = std::numeric_limits<double>::infinity();
+    while (_singleOk && _iters < _maxIter)
+    {
+        // Correct x with the single-precision factors.
+        for (int i = 0; i < _n; ++i)
+        {
+            d[i] = static_cast<float>(r[i]);
+        }
+        luSolve(_lu, _piv, d);
+        double correction = 0.0;
+        for (int i = 0; i < _n; ++i)
+        {
+            x[i] += d[i];
+            correction = std::max(correction, std::abs(double(d[i])));
+        }
+        ++_iters;
+
+        residual(b, x, r);
+        if (normInf(r) <= tol * (_normA * normInf(x) + normB))
+        {
+            return true;
+        }
+        if (!(correction < 0.5 * prevCorrection))
+        {
+            break;  // refinement has stagnated or diverged
+        }
+        prevCorrection = correction;
+    }
+
+    _fellBack = true;
+    return solveDouble(b, x);
+}
+
+int MixedPrecisionSolver::iterations() const
+{
+    return _iters;
+}
+
+bool MixedPrecisionSolver::usedFallback() const
+{
+    return _fellBack;
+}
+
+void MixedPrecisionSolver::residual(const BasicVector<double>& b,
+                                    const BasicVector<double>& x,
+                                    BasicVector<double>& r) const
+{
+    r = b;
+    double* rp = r.begin();
+    for (int j = 0; j < _n; ++j)
+    {
+        const double* c = _A[j].begin();
+        double xj = x[j];
+        for (int i = 0; i < _n; ++i)
+        {
+            rp[i] -= c[i] * xj;
+        }
+    }
+}
+
+/**
+ * Solves A x = b by LU factorization in double precision.
+ * The factors are computed on the first call.
+ */
+bool MixedPrecisionSolver::solveDouble(const BasicVector<double>& b,
+                                       BasicVector<double>& x)
+{
+    if (!_luD)
+    {
+        _luD.reset(new BasicMatrix<double>(_A));
+        _doubleOk = luFactor(*_luD, _pivD);
+    }
+    if (!_doubleOk)
+    {
+        return false;  // singular
+    }
+    x = b;
+    luSolve(*_luD, _pivD, x);
+    return true;
+}
+
+}  // namespace la
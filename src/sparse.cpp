@@ -0,0 +1,200 @@
+#include "inc/sparse.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace la
+{
+
+SparseMatrix::SparseMatrix(int m, int n)
+: _m{m},
+  _n{n},
+  _cp(n + 1, 0)
+{
+    assert(m > 0 && n > 0);
+}
+
+int SparseMatrix::rows() const
+{
+    return _m;
+}
+
+int SparseMatrix::cols() const
+{
+    return _n;
+}
+
+int SparseMatrix::nonzeros() const
+{
+    return _cp[_n];
+}
+
+const std::vector<int>& SparseMatrix::colPtr() const
+{
+    return _cp;
+}
+
+const std::vector<int>& SparseMatrix::rowIdx() const
+{
+    return _ri;
+}
+
+const std::vector<float>& SparseMatrix::values() const
+{
+    return _vals;
+}
+
+float SparseMatrix::at(int i, int j) const
+{
+    assert(i >= 0 && i < _m && j >= 0 && j < _n);
+    auto first = _ri.begin() + _cp[j];
+    auto last = _ri.begin() + _cp[j + 1];
+    auto it = std::lower_bound(first, last, i);
+    return (it != last && *it == i) ? _vals[it - _ri.begin()] : 0.0F;
+}
+
+/**
+ * Builds an m x n sparse matrix from (row, col, value) triplets.
+ * Duplicate entries are summed.
+ */
+SparseMatrix SparseMatrix::fromTriplets(int m, int n,
+                                        const std::vector<int>& rows,
+                                        const std::vector<int>& cols,
+                                        const std::vector<float>& vals)
+{
+    assert(rows.size() == cols.size() && rows.size() == vals.size());
+    SparseMatrix A(m, n);
+
+    // Counting sort of the triplets by column.
+    for (int c : cols)
+    {
+        assert(c >= 0 && c < n);
+        ++A._cp[c + 1];
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        A._cp[j + 1] += A._cp[j];
+    }
+    std::vector<int> next(A._cp.begin(), A._cp.end() - 1);
+    std::vector<std::pair<int, float>> entries(vals.size());
+    for (std::size_t k = 0; k < vals.size(); ++k)
+    {
+        assert(rows[k] >= 0 && rows[k] < m);
+        entries[next[cols[k]]++] = {rows[k], vals[k]};
+    }
+
+    // Sort each column by row and merge duplicates.
+    A._ri.reserve(entries.size());
+    A._vals.reserve(entries.size());
+    int nz = 0;
+    for (int j = 0; j < n; ++j)
+    {
+        auto first = entries.begin() + A._cp[j];
+        auto last = entries.begin() + A._cp[j + 1];
+        std::sort(first, last,
+                  [](const std::pair<int, float>& a,
+                     const std::pair<int, float>& b)
+                  { return a.first < b.first; });
+        A._cp[j] = nz;
+        for (auto it = first; it != last; ++it)
+        {
+            if (nz > A._cp[j] && A._ri.back() == it->first)
+            {
+                A._vals.back() += it->second;
+                continue;
+            }
+            A._ri.push_back(it->first);
+            A._vals.push_back(it->second);
+            ++nz;
+        }
+    }
+    A._cp[n] = nz;
+    return A;
+}
+
+SparseMatrix SparseMatrix::fromDense(const Matrix& A, float dropTol)
+{
+    SparseMatrix S(A.rows(), A.cols());
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int i = 0; i < A.rows(); ++i)
+        {
+            float entry = A[j][i];
+            if (entry > dropTol || entry < -dropTol)
+            {
+                S._ri.push_back(i);
+                S._vals.push_back(entry);
+            }
+        }
+        S._cp[j + 1] = S._ri.size();
+    }
+    return S;
+}
+
+SparseMatrix SparseMatrix::identity(int n)
+{
+    SparseMatrix I(n, n);
+    I._ri.resize(n);
+    I._vals.assign(n, 1.0F);
+    for (int j = 0; j < n; ++j)
+    {
+        I._ri[j] = j;
+        I._cp[j + 1] = j + 1;
+    }
+    return I;
+}
+
+Vector operator*(const SparseMatrix& A, const Vector& x)
+{
+    assert(A.cols() == x.size());
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+    const std::vector<float>& vals = A.values();
+    Vector b(A.rows(), 0.0F);
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        float xj = x[j];
+        for (int p = cp[j]; p < cp[j + 1]; ++p)
+        {
+            b[ri[p]] += vals[p] * xj;
+        }
+    }
+    return b;
+}
+
+Matrix toDense(const SparseMatrix& A)
+{
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+    const std::vector<float>& vals = A.values();
+    Matrix D(A.rows(), A.cols(), 0.0F);
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int p = cp[j]; p < cp[j + 1]; ++p)
+        {
+            D[j][ri[p]] = vals[p];
+        }
+    }
+    return D;
+}
+
+SparseMatrix transpose(const SparseMatrix& A)
+{
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+    std::vector<int> rows, cols;
+    rows.reserve(A.nonzeros());
+    cols.reserve(A.nonzeros());
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        for (int p = cp[j]; p < cp[j + 1]; ++p)
+        {
+            rows.push_back(j);
+            cols.push_back(ri[p]);
+        }
+    }
+    return SparseMatrix::fromTriplets(A.cols(), A.rows(), rows, cols,
+                                      A.values());
+}
+
+}  // namespace la
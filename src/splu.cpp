@@ -0,0 +1,359 @@
+#include "inc/splu.h"
+#include "inc/instrument.h"
+#include <algorithm>  // min()
+#include <cassert>
+#include <cmath>
+#include <set>
+#include <utility>
+
+namespace la
+{
+
+/**
+ * Computes an approximate minimum degree ordering of the pattern of A + A^T.
+ * Eliminated variables are represented implicitly by elements (cliques) of
+ * a quotient graph, and each variable's degree is bounded above by the sum
+ * of the sizes of its adjacent elements plus its remaining variable
+ * neighbors rather than computed exactly.
+ * Returns a permutation q such that q[k] is the kth variable to eliminate.
+ */
+std::vector<int> minimumDegreeOrder(const SparseMatrix& A)
+{
+    assert(A.rows() == A.cols());
+    int n = A.cols();
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+
+    std::vector<std::set<int>> varAdj(n);   // adjacent uneliminated variables
+    std::vector<std::set<int>> elemAdj(n);  // adjacent elements
+    std::vector<std::vector<int>> elemVars(n);  // variables of element e
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = cp[j]; p < cp[j + 1]; ++p)
+        {
+            if (ri[p] != j)
+            {
+                varAdj[j].insert(ri[p]);
+                varAdj[ri[p]].insert(j);
+            }
+        }
+    }
+
+    std::vector<int> deg(n);
+    std::set<std::pair<int, int>> queue;  // (approximate degree, variable)
+    for (int i = 0; i < n; ++i)
+    {
+        deg[i] = varAdj[i].size();
+        queue.insert({deg[i], i});
+    }
+
+    std::vector<bool> eliminated(n, false);
+    std::vector<int> mark(n, -1);
+    std::vector<int> order;
+    order.reserve(n);
+    for (int k = 0; k < n; ++k)
+    {
+        int p = queue.begin()->second;
+        queue.erase(queue.begin());
+        eliminated[p] = true;
+        order.push_back(p);
+
+        // The new element p covers p's variable neighbors together with the
+        // variables of every element it absorbs.
+        std::vector<int> lp;
+        for (int v : varAdj[p])
+        {
+            mark[v] = k;
+            lp.push_back(v);
+        }
+        for (int e : elemAdj[p])
+        {
+            for (int v : elemVars[e])
+            {
+                if (!eliminated[v] && mark[v] != k)
+                {
+                    mark[v] = k;
+                    lp.push_back(v);
+                }
+            }
+        }
+        std::set<int> absorbed;
+        absorbed.swap(elemAdj[p]);
+        for (int e : absorbed)
+        {
+            std::vector<int>().swap(elemVars[e]);
+        }
+        elemVars[p] = lp;
+        varAdj[p].clear();
+
+        // Update the neighbors of p. Variable edges inside the new element
+        // are redundant and pruned.
+        int remaining = n - k - 1;
+        for (int i : lp)
+        {
+            std::set<int>& adj = varAdj[i];
+            for (auto it = adj.begin(); it != adj.end(); )
+            {
+                it = (*it == p || mark[*it] == k) ? adj.erase(it) : ++it;
+            }
+            for (int e : absorbed)
+            {
+                elemAdj[i].erase(e);
+            }
+            elemAdj[i].insert(p);
+
+            int d = adj.size();
+            for (int e : elemAdj[i])
+            {
+                d += elemVars[e].size() - 1;
+            }
+            d = std::min(d, remaining - 1);
+            queue.erase({deg[i], i});
+            deg[i] = d;
+            queue.insert({d, i});
+        }
+    }
+    return order;
+}
+
+SparseLU::SparseLU(float pivotThreshold)
+: _tol{pivotThreshold},
+  _n{0},
+  _factored{false}
+{
+    assert(pivotThreshold > 0.0F && pivotThreshold <= 1.0F);
+}
+
+/**
+ * Performs symbolic analysis of A: computes a fill-reducing column ordering.
+ * Must be called before factor(), and again only if A's pattern changes.
+ */
+void SparseLU::analyze(const SparseMatrix& A)
+{
+    LA_PROFILE("SparseLU::analyze", 0, 0);
+    assert(A.rows() == A.cols());
+    _n = A.cols();
+    _q = minimumDegreeOrder(A);
+    _factored = false;
+}
+
+/**
+ * Numerically factors A, which must have the pattern last passed to
+ * analyze(). Uses left-looking (Gilbert-Peierls) elimination: each column
+ * of L and U is found by a sparse triangular solve whose nonzero pattern is
+ * computed in advance by depth-first search on the graph of L.
+ * Returns false if A is found to be singular.
+ */
+bool SparseLU::factor(const SparseMatrix& A)
+{
+    LA_PROFILE("SparseLU::factor", 0, 0);
+    assert(_n > 0 && A.rows() == _n && A.cols() == _n);
+    int n = _n;
+    const std::vector<int>& cp = A.colPtr();
+    const std::vector<int>& ri = A.rowIdx();
+    const std::vector<float>& vals = A.values();
+
+    _factored = false;
+    _lp.assign(1, 0);
+    _li.clear();
+    _lx.clear();
+    _up.assign(1, 0);
+    _ui.clear();
+    _ux.clear();
+    _li.reserve(2 * A.nonzeros() + n);
+    _lx.reserve(2 * A.nonzeros() + n);
+    _ui.reserve(2 * A.nonzeros() + n);
+    _ux.reserve(2 * A.nonzeros() + n);
+
+    std::vector<int> pinv(n, -1);  // pinv[i] = k if row i is the kth pivot
+    std::vector<float> x(n, 0.0F); // dense work column
+    std::vector<int> xi(n);        // reach of current column, in xi[top..n)
+    std::vector<int> stack(n);     // DFS node stack
+    std::vector<int> pstack(n);    // DFS resume positions
+    std::vector<int> mark(n, -1);
+
+    for (int k = 0; k < n; ++k)
+    {
+        int col = _q[k];
+
+        // Find the rows reachable from A(:, col) in the graph of L, in
+        // topological order.
+        int top = n;
+        for (int p0 = cp[col]; p0 < cp[col + 1]; ++p0)
+        {
+            if (mark[ri[p0]] == k)
+            {
+                continue;
+            }
+            int head = 0;
+            stack[0] = ri[p0];
+            while (head >= 0)
+            {
+                int j = stack[head];
+                int J = pinv[j];
+                if (mark[j] != k)
+                {
+                    mark[j] = k;
+                    pstack[head] = (J < 0) ? 0 : _lp[J] + 1;
+                }
+                bool done = true;
+                int end = (J < 0) ? 0 : _lp[J + 1];
+                for (int p = pstack[head]; p < end; ++p)
+                {
+                    int i = _li[p];
+                    if (mark[i] != k)
+                    {
+                        pstack[head] = p + 1;
+                        stack[++head] = i;
+                        done = false;
+                        break;
+                    }
+                }
+                if (done)
+                {
+                    --head;
+                    xi[--top] = j;
+                }
+            }
+        }
+
+        // Solve L x = A(:, col) over the reach.
+        for (int p = cp[col]; p < cp[col + 1]; ++p)
+        {
+            x[ri[p]] = vals[p];
+        }
+        for (int px = top; px < n; ++px)
+        {
+            int j = xi[px];
+            int J = pinv[j];
+            if (J < 0)
+            {
+                continue;
+            }
+            float xj = x[j];
+            for (int p = _lp[J] + 1; p < _lp[J + 1]; ++p)
+            {
+                x[_li[p]] -= _lx[p] * xj;
+            }
+        }
+
+        // Entries in pivot rows belong to U; the rest are pivot candidates.
+        int pivotRow = -1;
+        float maxVal = 0.0F;
+        for (int px = top; px < n; ++px)
+        {
+            int i = xi[px];
+            if (pinv[i] < 0)
+            {
+                float val = std::abs(x[i]);
+                if (val > maxVal)
+                {
+                    maxVal = val;
+                    pivotRow = i;
+                }
+            }
+            else
+            {
+                _ui.push_back(pinv[i]);
+                _ux.push_back(x[i]);
+            }
+        }
+        if (pivotRow == -1)
+        {
+            return false;  // structurally or numerically singular
+        }
+        if (pinv[col] < 0 && std::abs(x[col]) >= _tol * maxVal)
+        {
+            pivotRow = col;  // keep the diagonal to preserve the ordering
+        }
+
+        float pivot = x[pivotRow];
+        _ui.push_back(k);
+        _ux.push_back(pivot);
+        _up.push_back(_ui.size());
+        pinv[pivotRow] = k;
+        _li.push_back(pivotRow);
+        _lx.push_back(1.0F);
+        for (int px = top; px < n; ++px)
+        {
+            int i = xi[px];
+            if (pinv[i] < 0)
+            {
+                _li.push_back(i);
+                _lx.push_back(x[i] / pivot);
+            }
+            x[i] = 0.0F;
+        }
+        _lp.push_back(_li.size());
+    }
+
+    _p.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        _p[pinv[i]] = i;
+    }
+    _factored = true;
+    return true;
+}
+
+/**
+ * Solves A x = b using the most recent factorization.
+ * Returns false if there is no valid factorization.
+ */
+bool SparseLU::solve(const Vector& b, Vector& x) const
+{
+    LA_PROFILE("SparseLU::solve", 0, 0);
+    assert(b.size() == _n && x.size() == _n);
+    if (!_factored)
+    {
+        return false;
+    }
+
+    // Forward substitution with L, whose row indices are those of A.
+    std::vector<float> w(b.begin(), b.end());
+    std::vector<float> z(_n);
+    for (int k = 0; k < _n; ++k)
+    {
+        float zk = w[_p[k]];
+        z[k] = zk;
+        for (int p = _lp[k] + 1; p < _lp[k + 1]; ++p)
+        {
+            w[_li[p]] -= _lx[p] * zk;
+        }
+    }
+
+    // Back substitution with U.
+    for (int k = _n - 1; k >= 0; --k)
+    {
+        int diag = _up[k + 1] - 1;
+        z[k] /= _ux[diag];
+        float zk = z[k];
+        for (int p = _up[k]; p < diag; ++p)
+        {
+            z[_ui[p]] -= _ux[p] * zk;
+        }
+    }
+
+    for (int k = 0; k < _n; ++k)
+    {
+        x[_q[k]] = z[k];
+    }
+    return true;
+}
+
+int SparseLU::size() const
+{
+    return _n;
+}
+
+int SparseLU::nonzerosL() const
+{
+    return _li.size();
+}
+
+int SparseLU::nonzerosU() const
+{
+    return _ui.size();
+}
+
+}  // namespace la
@@ -0,0 +1,802 @@
+#include "inc/tiled.h"
+#include "inc/instrument.h"
+#include "inc/matrix.h"
+#include "inc/trace.h"
+#include <algorithm>  // fill(), min()
+#include <cassert>
+#include <climits>
+#include <complex>
+#include <cstdio>  // rename()
+#include <cstring>
+#include <fstream>
+#include <utility>  // swap()
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace la
+{
+
+namespace
+{
+
+const char MAGIC[8] = {'L', 'A', 'T', 'I', 'L', 'E', 'D', '\0'};
+const char CHECKPOINT_MAGIC[8] = {'L', 'A', 'C', 'K', 'P', 'T', '\0', '\0'};
+
+// The tiles start on a page boundary.
+const std::uint64_t DATA_OFFSET = 4096;
+static_assert(sizeof(TiledHeader) <= DATA_OFFSET, "header overlaps data");
+
+// Reads or writes all n bytes at offset, retrying short transfers.
+bool readAll(int fd, void* p, std::size_t n, std::uint64_t offset)
+{
+    char* b = static_cast<char*>(p);
+    while (n > 0)
+    {
+        ssize_t k = ::pread(fd, b, n, offset);
+        if (k <= 0)
+        {
+            return false;
+        }
+        b += k;
+        n -= k;
+        offset += k;
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void* p, std::size_t n, std::uint64_t offset)
+{
+    const char* b = static_cast<const char*>(p);
+    while (n > 0)
+    {
+        ssize_t k = ::pwrite(fd, b, n, offset);
+        if (k <= 0)
+        {
+            return false;
+        }
+        b += k;
+        n -= k;
+        offset += k;
+    }
+    return true;
+}
+
+/**
+ * Reads the pivots of the panels an interrupted factorization of an n x n
+ * matrix with tiles of order t completed. Returns false if there is no
+ * checkpoint for such a factorization at path.
+ */
+bool readCheckpoint(const std::string& path, int n, int t,
+                    std::vector<int>& piv)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[8];
+    std::int64_t h[3];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(h), sizeof(h));
+    if (!in || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0
+        || h[0] != n || h[1] != t || h[2] < 0 || h[2] > n
+        || (h[2] % t != 0 && h[2] != n))
+    {
+        return false;
+    }
+    piv.resize(h[2]);
+    in.read(reinterpret_cast<char*>(piv.data()), piv.size() * sizeof(int));
+    return static_cast<bool>(in);
+}
+
+/**
+ * Records the pivots of the panels completed so far, replacing the
+ * previous checkpoint only once the new one is fully written.
+ */
+bool writeCheckpoint(const std::string& path, int n, int t,
+                     const std::vector<int>& piv)
+{
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary);
+        std::int64_t h[3] = {n, t, static_cast<std::int64_t>(piv.size())};
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        out.write(reinterpret_cast<const char*>(h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(piv.data()),
+                  piv.size() * sizeof(int));
+        if (!out.flush())
+        {
+            return false;
+        }
+    }
+    return std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Factors rows r0 and below of the panel P with partial pivoting, as
+ * luFactor() does, recording the interchanges in piv[r0], piv[r0 + 1], ...
+ * Returns false if a pivot is zero.
+ */
+template <typename T>
+bool factorPanel(const BasicMatrixView<T>& P, int r0, std::vector<int>& piv)
+{
+    int m = P.rows();
+    int w = P.cols();
+    for (int k = 0; k < w; ++k)
+    {
+        int r = r0 + k;
+        T* ck = &P(0, k);
+        int p = r;
+        for (int i = r + 1; i < m; ++i)
+        {
+            if (std::abs(ck[i]) > std::abs(ck[p]))
+            {
+                p = i;
+            }
+        }
+        piv.push_back(p);
+        trace::record(trace::EventType::Pivot, p, -1, r, ck[p]);
+        if (ck[p] == T(0))
+        {
+            return false;
+        }
+        if (p != r)
+        {
+            for (int j = 0; j < w; ++j)
+            {
+                std::swap(P(r, j), P(p, j));
+            }
+        }
+
+        T scale = T(1) / ck[r];
+        for (int i = r + 1; i < m; ++i)
+        {
+            ck[i] *= scale;
+        }
+        for (int j = k + 1; j < w; ++j)
+        {
+            T* cj = &P(0, j);
+            T f = cj[r];
+            for (int i = r + 1; i < m; ++i)
+            {
+                cj[i] -= ck[i] * f;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Applies the factored panel K of A to the panel P of a later tile
+ * column, as right-looking elimination would have: P's rows are
+ * interchanged as panel K's were, its rows in tile row K are solved with
+ * the unit lower triangle of tile (K, K), and the rows below are updated.
+ */
+template <typename T>
+void updatePanel(BasicTiledMatrix<T>& A, const std::vector<int>& piv, int K,
+                 const BasicMatrixView<T>& P)
+{
+    int t = A.tileSize();
+    int r0 = K * t;
+    int w = P.cols();
+    for (int i = r0; i < r0 + t && i < A.rows(); ++i)
+    {
+        if (piv[i] != i)
+        {
+            for (int j = 0; j < w; ++j)
+            {
+                std::swap(P(i, j), P(piv[i], j));
+            }
+        }
+    }
+
+    A.prefetch(K + 1, K);
+    BasicMatrixView<T> L = A.acquire(K, K);
+    BasicMatrixView<T> PK = P.block(r0, 0, L.rows(), w);
+    for (int j = 0; j < w; ++j)
+    {
+        for (int k = 0; k < L.cols(); ++k)
+        {
+            T f = PK(k, j);
+            for (int i = k + 1; i < L.rows(); ++i)
+            {
+                PK(i, j) -= L(i, k) * f;
+            }
+        }
+    }
+    A.release(K, K);
+
+    for (int I = K + 1; I < A.tileRows(); ++I)
+    {
+        A.prefetch(I + 1, K);
+        BasicMatrixView<T> LI = A.acquire(I, K);
+        gemm(Op::NoTrans, Op::NoTrans, T(-1), LI, PK, T(1),
+             P.block(I * t, 0, LI.rows(), w));
+        A.release(I, K);
+    }
+}
+
+}  // namespace
+
+template <typename T>
+BasicTiledMatrix<T>::BasicTiledMatrix()
+: _fd{-1},
+  _m{0},
+  _n{0},
+  _t{1},
+  _clock{0},
+  _reads{0},
+  _writes{0},
+  _failed{false}
+{}
+
+template <typename T>
+BasicTiledMatrix<T>::~BasicTiledMatrix()
+{
+    close();
+}
+
+/**
+ * Creates a tiled matrix file at path for a rows x cols matrix of zeros,
+ * with tiles of order tile, closing any file already open. The file is
+ * sparse, so creating it does not write the entries. Returns false if the
+ * file cannot be created.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::create(const std::string& path, int rows, int cols,
+                                 int tile, int cacheTiles)
+{
+    assert(rows > 0 && cols > 0 && tile > 0 && cacheTiles > 0);
+    close();
+    TiledHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = TILED_VERSION;
+    h.dtype = static_cast<std::uint32_t>(BinaryTypeOf<T>::value);
+    h.rows = rows;
+    h.cols = cols;
+    h.tile = tile;
+    h.dataOffset = DATA_OFFSET;
+    std::uint64_t tiles = std::uint64_t((rows + tile - 1) / tile)
+                          * ((cols + tile - 1) / tile);
+    std::uint64_t length = DATA_OFFSET
+                           + tiles * tile * tile * sizeof(T);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (tiles > INT_MAX || !writeAll(fd, &h, sizeof(h), 0)
+        || ::ftruncate(fd, length) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    _fd = fd;
+    _m = rows;
+    _n = cols;
+    _t = tile;
+    _cache.assign(std::size_t(cacheTiles) * tile * tile, T(0));
+    _slots.assign(cacheTiles, Slot{-1, 0, false, 0});
+    return true;
+}
+
+/**
+ * Opens the tiled matrix file at path, closing any file already open.
+ * Returns false if the file cannot be opened or does not hold a tiled
+ * matrix of T.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::open(const std::string& path, int cacheTiles)
+{
+    assert(cacheTiles > 0);
+    close();
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0)
+    {
+        return false;
+    }
+    TiledHeader h;
+    struct stat st;
+    bool valid = readAll(fd, &h, sizeof(h), 0) && ::fstat(fd, &st) == 0
+                 && std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0
+                 && h.version == TILED_VERSION
+                 && h.dtype == static_cast<std::uint32_t>(
+                        BinaryTypeOf<T>::value)
+                 && h.rows > 0 && h.rows <= INT_MAX && h.cols > 0
+                 && h.cols <= INT_MAX && h.tile > 0 && h.tile <= INT_MAX
+                 && h.dataOffset == DATA_OFFSET;
+    if (valid)
+    {
+        std::uint64_t tiles = std::uint64_t((h.rows + h.tile - 1) / h.tile)
+                              * ((h.cols + h.tile - 1) / h.tile);
+        valid = tiles <= INT_MAX
+                && std::uint64_t(st.st_size)
+                       >= DATA_OFFSET + tiles * h.tile * h.tile * sizeof(T);
+    }
+    if (!valid)
+    {
+        ::close(fd);
+        return false;
+    }
+    _fd = fd;
+    _m = h.rows;
+    _n = h.cols;
+    _t = h.tile;
+    _cache.assign(std::size_t(cacheTiles) * _t * _t, T(0));
+    _slots.assign(cacheTiles, Slot{-1, 0, false, 0});
+    return true;
+}
+
+/**
+ * Writes back modified tiles and closes the file, if any.
+ * Returns false if an I/O error occurred since the file was opened.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::close()
+{
+    if (_fd < 0)
+    {
+        return true;
+    }
+    bool ok = flush();
+    ::close(_fd);
+    _fd = -1;
+    _m = 0;
+    _n = 0;
+    _t = 1;
+    _cache.clear();
+    _slots.clear();
+    _where.clear();
+    _clock = 0;
+    _reads = 0;
+    _writes = 0;
+    _failed = false;
+    return ok;
+}
+
+template <typename T>
+bool BasicTiledMatrix<T>::isOpen() const
+{
+    return _fd >= 0;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::rows() const
+{
+    return _m;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::cols() const
+{
+    return _n;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::tileSize() const
+{
+    return _t;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::tileRows() const
+{
+    return (_m + _t - 1) / _t;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::tileCols() const
+{
+    return (_n + _t - 1) / _t;
+}
+
+/**
+ * Returns a view of tile (I, J), reading it into the cache if needed.
+ * Tiles on the bottom and right edges are smaller than tileSize().
+ * The tile stays in the cache until it is released; a tile acquired for
+ * writing is written back to the file after that.
+ */
+template <typename T>
+BasicMatrixView<T> BasicTiledMatrix<T>::acquire(int I, int J, bool write)
+{
+    assert(isOpen() && I >= 0 && I < tileRows() && J >= 0 && J < tileCols());
+    int tile = index(I, J);
+    int s;
+    auto it = _where.find(tile);
+    if (it != _where.end())
+    {
+        s = it->second;
+    }
+    else
+    {
+        // Evict the least recently used tile that is not in use.
+        s = -1;
+        for (int k = 0; k < static_cast<int>(_slots.size()); ++k)
+        {
+            if (_slots[k].pins == 0
+                && (s < 0 || _slots[k].used < _slots[s].used))
+            {
+                s = k;
+            }
+        }
+        assert(s >= 0 && "every cached tile is in use");
+        if (_slots[s].tile >= 0)
+        {
+            if (_slots[s].dirty)
+            {
+                writeTile(s);
+            }
+            _where.erase(_slots[s].tile);
+        }
+        _slots[s].tile = tile;
+        _slots[s].dirty = false;
+        _where[tile] = s;
+        readTile(s);
+    }
+    Slot& slot = _slots[s];
+    ++slot.pins;
+    slot.used = ++_clock;
+    slot.dirty = slot.dirty || write;
+    return BasicMatrixView<T>(entries(s), std::min(_t, _m - I * _t),
+                              std::min(_t, _n - J * _t), _t);
+}
+
+// Ends the use of tile (I, J) begun by acquire().
+template <typename T>
+void BasicTiledMatrix<T>::release(int I, int J)
+{
+    auto it = _where.find(index(I, J));
+    assert(it != _where.end() && _slots[it->second].pins > 0);
+    --_slots[it->second].pins;
+}
+
+/**
+ * Asks the kernel to start reading tile (I, J) in the background, so a
+ * later acquire() overlaps less with computation. Does nothing for tiles
+ * already cached or outside the matrix.
+ */
+template <typename T>
+void BasicTiledMatrix<T>::prefetch(int I, int J) const
+{
+    if (!isOpen() || I < 0 || I >= tileRows() || J < 0 || J >= tileCols()
+        || _where.count(index(I, J)) != 0)
+    {
+        return;
+    }
+    ::posix_fadvise(_fd, offset(index(I, J)), sizeof(T) * _t * _t,
+                    POSIX_FADV_WILLNEED);
+}
+
+/**
+ * Writes back every modified tile and waits for the file to reach the
+ * disk. Returns false if an I/O error occurred since the file was opened.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::flush()
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+    for (int s = 0; s < static_cast<int>(_slots.size()); ++s)
+    {
+        if (_slots[s].tile >= 0 && _slots[s].dirty)
+        {
+            writeTile(s);
+        }
+    }
+    if (::fdatasync(_fd) != 0)
+    {
+        _failed = true;
+    }
+    return !_failed;
+}
+
+template <typename T>
+bool BasicTiledMatrix<T>::failed() const
+{
+    return _failed;
+}
+
+/**
+ * Reads the whole matrix into A, which must have the same shape.
+ * Returns false if an I/O error has occurred.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::read(const BasicMatrixView<T>& A)
+{
+    assert(A.rows() == _m && A.cols() == _n);
+    for (int J = 0; J < tileCols(); ++J)
+    {
+        for (int I = 0; I < tileRows(); ++I)
+        {
+            BasicMatrixView<T> V = acquire(I, J);
+            copy(V, A.block(I * _t, J * _t, V.rows(), V.cols()));
+            release(I, J);
+        }
+    }
+    return !_failed;
+}
+
+/**
+ * Replaces the whole matrix with A, which must have the same shape.
+ * Returns false if an I/O error has occurred.
+ */
+template <typename T>
+bool BasicTiledMatrix<T>::write(const BasicConstMatrixView<T>& A)
+{
+    assert(A.rows() == _m && A.cols() == _n);
+    for (int J = 0; J < tileCols(); ++J)
+    {
+        for (int I = 0; I < tileRows(); ++I)
+        {
+            BasicMatrixView<T> V = acquire(I, J, true);
+            copy(A.block(I * _t, J * _t, V.rows(), V.cols()), V);
+            release(I, J);
+        }
+    }
+    return !_failed;
+}
+
+template <typename T>
+long long BasicTiledMatrix<T>::tileReads() const
+{
+    return _reads;
+}
+
+template <typename T>
+long long BasicTiledMatrix<T>::tileWrites() const
+{
+    return _writes;
+}
+
+template <typename T>
+int BasicTiledMatrix<T>::index(int I, int J) const
+{
+    return I + J * tileRows();
+}
+
+template <typename T>
+std::uint64_t BasicTiledMatrix<T>::offset(int tile) const
+{
+    return DATA_OFFSET + std::uint64_t(tile) * _t * _t * sizeof(T);
+}
+
+template <typename T>
+T* BasicTiledMatrix<T>::entries(int slot)
+{
+    return _cache.data() + std::size_t(slot) * _t * _t;
+}
+
+// Reads the tile of a cache slot from the file, or zeros it on failure.
+template <typename T>
+bool BasicTiledMatrix<T>::readTile(int slot)
+{
+    T* p = entries(slot);
+    ++_reads;
+    if (!readAll(_fd, p, sizeof(T) * _t * _t, offset(_slots[slot].tile)))
+    {
+        std::fill(p, p + std::size_t(_t) * _t, T(0));
+        _failed = true;
+        return false;
+    }
+    return true;
+}
+
+// Writes the tile of a cache slot back to the file.
+template <typename T>
+bool BasicTiledMatrix<T>::writeTile(int slot)
+{
+    ++_writes;
+    if (!writeAll(_fd, entries(slot), sizeof(T) * _t * _t,
+                  offset(_slots[slot].tile)))
+    {
+        _failed = true;
+        return false;
+    }
+    _slots[slot].dirty = false;
+    return true;
+}
+
+/**
+ * Computes C = alpha A B + beta C one tile of C at a time. The inner
+ * dimension is walked in alternating directions, so the tiles of A and B
+ * last used for one tile of C are still cached for the next, and the next
+ * pair of tiles is prefetched while the current pair is multiplied.
+ * The three matrices must be distinct, with equal tile sizes.
+ * Returns false if an I/O error occurs.
+ */
+template <typename T>
+bool gemm(typename BasicMatrixView<T>::value_type alpha,
+          BasicTiledMatrix<T>& A, BasicTiledMatrix<T>& B,
+          typename BasicMatrixView<T>::value_type beta,
+          BasicTiledMatrix<T>& C)
+{
+    assert(A.rows() == C.rows() && B.cols() == C.cols()
+           && A.cols() == B.rows());
+    assert(A.tileSize() == C.tileSize() && B.tileSize() == C.tileSize());
+    LA_PROFILE("tiledGemm", 2.0 * A.rows() * A.cols() * B.cols(), 0);
+    int kt = A.tileCols();
+    bool forward = true;
+    for (int J = 0; J < C.tileCols(); ++J)
+    {
+        for (int I = 0; I < C.tileRows(); ++I)
+        {
+            BasicMatrixView<T> CIJ = C.acquire(I, J, true);
+            if (beta == T(0))
+            {
+                fill(CIJ, T(0));
+            }
+            else if (beta != T(1))
+            {
+                scale(beta, CIJ);
+            }
+            for (int step = 0; step < kt; ++step)
+            {
+                int K = forward ? step : kt - 1 - step;
+                int next = forward ? K + 1 : K - 1;
+                A.prefetch(I, next);
+                B.prefetch(next, J);
+                gemm(Op::NoTrans, Op::NoTrans, alpha, A.acquire(I, K),
+                     B.acquire(K, J), T(1), CIJ);
+                A.release(I, K);
+                B.release(K, J);
+            }
+            C.release(I, J);
+            forward = !forward;
+        }
+    }
+    return !A.failed() && !B.failed() && C.flush();
+}
+
+/**
+ * Factors the square matrix A in place by left-looking LU with partial
+ * pivoting, a tile column (panel) at a time. Panel J is read into memory,
+ * updated by each earlier panel in turn, factored and written back, so
+ * each step changes only its own panel and the earlier panels' tiles are
+ * only read. Unlike luFactor() on a BasicMatrix, the interchanges of a
+ * panel are not applied to the columns of earlier panels; luSolve()
+ * accounts for this.
+ *
+ * If checkpoint names a file, the pivots are saved there after each panel
+ * reaches the disk, and a factorization interrupted at any point resumes
+ * from the last saved panel when called again with the same checkpoint.
+ * At most maxPanels panels are factored by one call, if maxPanels is not
+ * negative. Returns false if A is singular, an I/O error occurs, or the
+ * factorization stopped after maxPanels panels; piv then holds the pivots
+ * of the completed panels.
+ */
+template <typename T>
+bool luFactor(BasicTiledMatrix<T>& A, std::vector<int>& piv,
+              const std::string& checkpoint, int maxPanels)
+{
+    assert(A.rows() == A.cols());
+    LA_PROFILE("tiledLuFactor", 2.0 / 3 * A.rows() * A.rows() * A.rows(), 0);
+    int n = A.rows();
+    int t = A.tileSize();
+    if (checkpoint.empty() || !readCheckpoint(checkpoint, n, t, piv))
+    {
+        piv.clear();
+    }
+    int factored = 0;
+    int done = (static_cast<int>(piv.size()) + t - 1) / t;
+    for (int J = done; J < A.tileCols(); ++J)
+    {
+        if (factored++ == maxPanels)
+        {
+            return false;
+        }
+        BasicMatrix<T> P(n, std::min(t, n - J * t));
+        for (int I = 0; I < A.tileRows(); ++I)
+        {
+            A.prefetch(I + 1, J);
+            BasicMatrixView<T> V = A.acquire(I, J);
+            copy(V, P.block(I * t, 0, V.rows(), V.cols()));
+            A.release(I, J);
+        }
+        for (int K = 0; K < J; ++K)
+        {
+            updatePanel(A, piv, K, P);
+        }
+        if (!factorPanel(P, J * t, piv))
+        {
+            return false;
+        }
+        for (int I = 0; I < A.tileRows(); ++I)
+        {
+            BasicMatrixView<T> V = A.acquire(I, J, true);
+            copy(P.block(I * t, 0, V.rows(), V.cols()), V);
+            A.release(I, J);
+        }
+        if (!A.flush()
+            || (!checkpoint.empty() && !writeCheckpoint(checkpoint, n, t, piv)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Solves A x = b given the factorization of A computed by luFactor() on
+ * the tiled matrix LU. On return, b holds x. Returns false if an I/O
+ * error occurs.
+ */
+template <typename T>
+bool luSolve(BasicTiledMatrix<T>& LU, const std::vector<int>& piv,
+             BasicVector<T>& b)
+{
+    int n = LU.rows();
+    int t = LU.tileSize();
+    int nt = LU.tileRows();
+    assert(LU.cols() == n && b.size() == n
+           && static_cast<int>(piv.size()) == n);
+    T* x = b.begin();
+    for (int K = 0; K < nt; ++K)
+    {
+        int r0 = K * t;
+        BasicMatrixView<T> L = LU.acquire(K, K);
+        for (int i = r0; i < r0 + L.rows(); ++i)
+        {
+            std::swap(x[i], x[piv[i]]);
+        }
+        for (int k = 0; k < L.cols(); ++k)
+        {
+            for (int i = k + 1; i < L.rows(); ++i)
+            {
+                x[r0 + i] -= L(i, k) * x[r0 + k];
+            }
+        }
+        BasicConstVectorView<T> xK(x + r0, L.cols());
+        LU.release(K, K);
+        for (int I = K + 1; I < nt; ++I)
+        {
+            LU.prefetch(I + 1, K);
+            BasicMatrixView<T> LI = LU.acquire(I, K);
+            gemv(T(-1), LI, xK, T(1),
+                 BasicVectorView<T>(x + I * t, LI.rows()));
+            LU.release(I, K);
+        }
+    }
+    for (int J = nt - 1; J >= 0; --J)
+    {
+        int r0 = J * t;
+        BasicMatrixView<T> U = LU.acquire(J, J);
+        for (int k = U.cols() - 1; k >= 0; --k)
+        {
+            x[r0 + k] /= U(k, k);
+            for (int i = 0; i < k; ++i)
+            {
+                x[r0 + i] -= U(i, k) * x[r0 + k];
+            }
+        }
+        BasicConstVectorView<T> xJ(x + r0, U.cols());
+        LU.release(J, J);
+        for (int I = 0; I < J; ++I)
+        {
+            LU.prefetch(I + 1, J);
+            BasicMatrixView<T> UI = LU.acquire(I, J);
+            gemv(T(-1), UI, xJ, T(1),
+                 BasicVectorView<T>(x + I * t, UI.rows()));
+            LU.release(I, J);
+        }
+    }
+    return !LU.failed();
+}
+
+#define LA_INSTANTIATE_TILED(T)                                               \
+    template class BasicTiledMatrix<T>;                                       \
+    template bool gemm(T, BasicTiledMatrix<T>&, BasicTiledMatrix<T>&, T,      \
+                       BasicTiledMatrix<T>&);                                 \
+    template bool luFactor(BasicTiledMatrix<T>&, std::vector<int>&,           \
+                           const std::string&, int);                          \
+    template bool luSolve(BasicTiledMatrix<T>&, const std::vector<int>&,      \
+                          BasicVector<T>&);
+
+LA_INSTANTIATE_TILED(float)
+LA_INSTANTIATE_TILED(double)
+LA_INSTANTIATE_TILED(std::complex<float>)
+LA_INSTANTIATE_TILED(std::complex<double>)
+
+#undef LA_INSTANTIATE_TILED
+
+}  // namespace la
@@ -0,0 +1,156 @@
+#include "inc/trace.h"
+#include <algorithm>  // sort()
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+namespace la
+{
+
+namespace trace
+{
+
+namespace
+{
+
+const char MAGIC[8] = {'L', 'A', 'T', 'R', 'A', 'C', 'E', '\0'};
+const std::uint32_t VERSION = 1;
+
+// Leads every trace file, followed by count events in host byte order.
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t eventSize;
+    std::uint64_t count;
+    std::uint64_t dropped;
+};
+
+std::vector<Event> ring;           // capacity is a power of two
+std::atomic<std::uint64_t> next{0};  // events recorded since start()
+
+}  // namespace
+
+namespace detail
+{
+
+std::atomic<bool> active{false};
+
+/**
+ * Claims the next slot of the ring, overwriting the oldest event once the
+ * ring is full. Safe to call from several threads at once.
+ */
+void append(EventType type, int row1, int row2, int col, double re,
+            double im)
+{
+    std::uint64_t seq = next.fetch_add(1, std::memory_order_relaxed) + 1;
+    Event& e = ring[(seq - 1) & (ring.size() - 1)];
+    e.type = type;
+    e.row1 = row1;
+    e.row2 = row2;
+    e.col = col;
+    e.re = re;
+    e.im = im;
+    e.seq = seq;
+}
+
+}  // namespace detail
+
+/**
+ * Clears the trace and starts recording into a ring of at least capacity
+ * events. Must not be called while tracing is on.
+ */
+void start(std::size_t capacity)
+{
+    assert(!detail::active);
+    std::size_t size = 1;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    ring.assign(size, Event{});
+    next = 0;
+    detail::active = true;
+}
+
+// Stops recording. The recorded events stay available until start().
+void stop()
+{
+    detail::active = false;
+}
+
+/**
+ * Returns the events held by the ring, oldest first. Call after stop(), or
+ * when no thread is recording, so that no event is read half-written.
+ */
+std::vector<Event> events()
+{
+    std::vector<Event> result;
+    for (const Event& e : ring)
+    {
+        if (e.seq != 0)
+        {
+            result.push_back(e);
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Event& a, const Event& b) { return a.seq < b.seq; });
+    return result;
+}
+
+// Returns the number of events overwritten since start().
+std::uint64_t dropped()
+{
+    std::uint64_t n = next;
+    return n > ring.size() ? n - ring.size() : 0;
+}
+
+/**
+ * Writes the events held by the ring to a trace file.
+ * Returns false if the file cannot be written.
+ */
+bool save(const std::string& path)
+{
+    std::vector<Event> evs = events();
+    Header h;
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.eventSize = sizeof(Event);
+    h.count = evs.size();
+    h.dropped = dropped();
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(evs.data()),
+              evs.size() * sizeof(Event));
+    return static_cast<bool>(out);
+}
+
+/**
+ * Reads a trace file written by save().
+ * Returns false if the file cannot be read or is not a trace file.
+ */
+bool load(const std::string& path, std::vector<Event>& events,
+          std::uint64_t& dropped)
+{
+    std::ifstream in(path, std::ios::binary);
+    Header h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))
+        || std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0
+        || h.version != VERSION || h.eventSize != sizeof(Event))
+    {
+        return false;
+    }
+    events.resize(h.count);
+    if (!in.read(reinterpret_cast<char*>(events.data()),
+                 h.count * sizeof(Event)))
+    {
+        return false;
+    }
+    dropped = h.dropped;
+    return true;
+}
+
+}  // namespace trace
+
+}  // namespace la
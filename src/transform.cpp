@@ -0,0 +1,162 @@
+#include "inc/transform.h"
+#include <algorithm>  // min()
+#include <cassert>
+#include <functional>  // cref()
+#include <thread>
+#include <vector>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace la
+{
+
+namespace
+{
+
+// Row-major copy of the transform's coefficients; row 3 is only read
+// for projective transforms.
+struct Coeffs
+{
+    float m[4][4];
+};
+
+/**
+ * Transforms points [lo, hi) of in to out. With Projective set, applies
+ * the perspective divide by the transformed w coordinate.
+ */
+template <bool Projective>
+void transformRange(const Coeffs& c, const PointsSoA& in, const PointsSoA& out,
+                    int lo, int hi)
+{
+    const float (*m)[4] = c.m;
+    int i = lo;
+#if defined(__SSE__)
+    __m128 r[4][4];
+    for (int a = 0; a < (Projective ? 4 : 3); ++a)
+    {
+        for (int b = 0; b < 4; ++b)
+        {
+            r[a][b] = _mm_set1_ps(m[a][b]);
+        }
+    }
+    for (; i + 4 <= hi; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(in.x + i);
+        __m128 y = _mm_loadu_ps(in.y + i);
+        __m128 z = _mm_loadu_ps(in.z + i);
+        __m128 t[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            t[a] = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(r[a][0], x), _mm_mul_ps(r[a][1], y)),
+                _mm_add_ps(_mm_mul_ps(r[a][2], z), r[a][3]));
+        }
+        if (Projective)
+        {
+            __m128 w = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(r[3][0], x), _mm_mul_ps(r[3][1], y)),
+                _mm_add_ps(_mm_mul_ps(r[3][2], z), r[3][3]));
+            __m128 inv = _mm_div_ps(_mm_set1_ps(1.0F), w);
+            for (int a = 0; a < 3; ++a)
+            {
+                t[a] = _mm_mul_ps(t[a], inv);
+            }
+        }
+        _mm_storeu_ps(out.x + i, t[0]);
+        _mm_storeu_ps(out.y + i, t[1]);
+        _mm_storeu_ps(out.z + i, t[2]);
+    }
+#endif
+    for (; i < hi; ++i)
+    {
+        float x = in.x[i], y = in.y[i], z = in.z[i];
+        float t[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            t[a] = m[a][0] * x + m[a][1] * y + m[a][2] * z + m[a][3];
+        }
+        if (Projective)
+        {
+            float inv = 1.0F / (m[3][0] * x + m[3][1] * y + m[3][2] * z
+                                + m[3][3]);
+            for (int a = 0; a < 3; ++a)
+            {
+                t[a] *= inv;
+            }
+        }
+        out.x[i] = t[0];
+        out.y[i] = t[1];
+        out.z[i] = t[2];
+    }
+}
+
+/**
+ * Splits the points into contiguous chunks, one per thread, each a
+ * multiple of the SIMD width so only the last chunk has a scalar tail.
+ */
+template <bool Projective>
+void transformAll(const Coeffs& c, const PointsSoA& in, const PointsSoA& out,
+                  int threads)
+{
+    assert(in.n == out.n && threads > 0);
+    int n = in.n;
+    int chunk = ((n + threads - 1) / threads + 3) & ~3;
+    if (threads == 1 || chunk >= n)
+    {
+        transformRange<Projective>(c, in, out, 0, n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int lo = chunk; lo < n; lo += chunk)
+    {
+        workers.emplace_back(transformRange<Projective>, std::cref(c),
+                             std::cref(in), std::cref(out), lo,
+                             std::min(n, lo + chunk));
+    }
+    transformRange<Projective>(c, in, out, 0, chunk);
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+}
+
+}  // namespace
+
+/**
+ * Applies projective transform M to each point p of in, writing
+ * dehomogenize(M * homogenize(p)) to out, over the given number of threads.
+ */
+void transformPoints(const FixedMatrix<4, 4>& M, const PointsSoA& in,
+                     const PointsSoA& out, int threads)
+{
+    Coeffs c;
+    for (int a = 0; a < 4; ++a)
+    {
+        for (int b = 0; b < 4; ++b)
+        {
+            c.m[a][b] = M[b][a];
+        }
+    }
+    transformAll<true>(c, in, out, threads);
+}
+
+/**
+ * Applies affine transform M to each point p of in, writing
+ * M * homogenize(p) to out, over the given number of threads.
+ */
+void transformPoints(const FixedMatrix<3, 4>& M, const PointsSoA& in,
+                     const PointsSoA& out, int threads)
+{
+    Coeffs c = {};
+    for (int a = 0; a < 3; ++a)
+    {
+        for (int b = 0; b < 4; ++b)
+        {
+            c.m[a][b] = M[b][a];
+        }
+    }
+    transformAll<false>(c, in, out, threads);
+}
+
+}  // namespace la
@@ -1,153 +1,206 @@
 #include "inc/vector.h"
 #include "inc/util.h"
+#include "inc/alloc.h"
+#include "inc/format.h"
+#include "inc/random.h"
 #include <cassert>
 #include <cmath>
-#include <cstdlib>
-#include <ctime>
+#include <complex>
 
 namespace la
 {
 
-Vector::Vector(int n)
+namespace
+{
+
+template <typename T>
+T roundScalar(T x)
+{
+    T rounded = std::round(x);  // to nearest integer
+    return (rounded == -0.0F) ? 0.0F : rounded;
+}
+
+template <typename T>
+std::complex<T> roundScalar(std::complex<T> z)
+{
+    return {roundScalar(z.real()), roundScalar(z.imag())};
+}
+
+}  // namespace
+
+template <typename T>
+BasicVector<T>::BasicVector(int n)
+: BasicVectorView<T>(nullptr, n),
+  _owns{true}
 {
     assert(n > 0);
-    _n = n;
-    _ep = new float[n];
+    _p = (n <= inlineCapacity()) ? reinterpret_cast<T*>(_buf)
+                                 : allocateArray<T>(n);
+    for (int i = 0; i < n; ++i)
+    {
+        new (_p + i) T;
+    }
 }
 
-Vector::Vector(int n, float initVal)
-: Vector(n)
+template <typename T>
+BasicVector<T>::BasicVector(int n, T initVal)
+: BasicVector(n)
 {
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] = initVal;
+        _p[i] = initVal;
     }
 }
 
-Vector::Vector(std::initializer_list<float> list)
-: Vector(list.size())
+template <typename T>
+BasicVector<T>::BasicVector(std::initializer_list<T> list)
+: BasicVector(list.size())
 {
     int i = 0;
-    for (float val : list)
+    for (T val : list)
     {
-        _ep[i++] = val;
+        _p[i++] = val;
     }
 }
 
-Vector::Vector(const Vector& v)
-: Vector(v._n)
+template <typename T>
+BasicVector<T>::BasicVector(const BasicVector& v)
+: BasicVector(v._n)
 {
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] = v[i];
+        _p[i] = v[i];
     }
 }
 
-Vector::~Vector()
+template <typename T>
+BasicVector<T>::BasicVector(const BasicConstVectorView<T>& v)
+: BasicVector(v.size())
 {
-    delete[] _ep;
+    for (int i = 0; i < _n; ++i)
+    {
+        _p[i] = v[i];
+    }
 }
 
-Vector& Vector::operator=(const Vector& v)
+template <typename T>
+BasicVector<T>::BasicVector(T* p, int n, bool owns)
+: BasicVectorView<T>(p, n),
+  _owns{owns}
+{}
+
+template <typename T>
+BasicVector<T>::~BasicVector()
+{
+    if (_owns && !isInline())
+    {
+        deallocateArray(_p, _n);
+    }
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator=(const BasicVector& v)
 {
     assert(_n == v._n);
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] = v[i];
+        _p[i] = v[i];
     }
     return *this;
 }
 
-Vector& Vector::operator+=(const Vector& v)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator+=(const BasicVector& v)
 {
     assert(_n == v._n);
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] += v[i];
+        _p[i] += v[i];
     }
     return *this;
 }
 
-Vector& Vector::operator-=(const Vector& v)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator-=(const BasicVector& v)
 {
     assert(_n == v._n);
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] -= v[i];
+        _p[i] -= v[i];
     }
     return *this;
 }
 
-Vector& Vector::operator*=(float x)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator*=(T x)
 {
     for (int i = 0; i < _n; ++i)
     {
-        _ep[i] *= x;
+        _p[i] *= x;
     }
     return *this;
 }
 
-float& Vector::operator[](int i)
+template <typename T>
+T& BasicVector<T>::operator[](int i)
 {
     assert(i >= 0 && i < _n);
-    return _ep[i];
+    return _p[i];
 }
 
-const float& Vector::operator[](int i) const
+template <typename T>
+const T& BasicVector<T>::operator[](int i) const
 {
     assert(i >= 0 && i < _n);
-    return _ep[i];
+    return _p[i];
 }
 
-float* Vector::begin()
+template <typename T>
+T* BasicVector<T>::begin()
 {
-    return _ep;
+    return _p;
 }
 
-const float* Vector::begin() const
+template <typename T>
+const T* BasicVector<T>::begin() const
 {
-    return _ep;
+    return _p;
 }
 
-float* Vector::end()
+template <typename T>
+T* BasicVector<T>::end()
 {
-    return _ep + _n;
+    return _p + _n;
 }
 
-const float* Vector::end() const
+template <typename T>
+const T* BasicVector<T>::end() const
 {
-    return _ep + _n;
+    return _p + _n;
 }
 
-int Vector::size() const
+template <typename T>
+bool BasicVector<T>::isInline() const
 {
-    return _n;
+    return _p == reinterpret_cast<const T*>(_buf);
 }
 
-Vector Vector::random(int n)
+template <typename T>
+BasicVector<T> BasicVector<T>::random(int n)
 {
-    static bool seeded = false;
-    if (!seeded)
-    {
-        std::srand(static_cast<unsigned int>(std::time(nullptr)));
-        seeded = true;
-    }
-    Vector r(n);
-    float denom = 1.0F / RAND_MAX;
-    for (float& entry : r)
-    {
-        entry = std::rand() * denom;  // in [0, 1]
-    }
-    return r;
+    return random(n, T(0), unitCorner(T(0)));
 }
 
-Vector Vector::random(int n, float lo, float hi)
+template <typename T>
+BasicVector<T> BasicVector<T>::random(int n, T lo, T hi)
 {
-    assert(hi >= lo);
-    return (hi - lo) * random(n) + Vector(n, lo);
+    BasicVector r(n);
+    fillUniform(BasicMatrixView<T>(r.begin(), n, 1, n), randomSeed(), lo, hi);
+    return r;
 }
 
-bool operator==(const Vector& v, const Vector& w)
+template <typename T>
+bool operator==(const BasicVector<T>& v, const BasicVector<T>& w)
 {
     if (&v == &w)
     {
@@ -167,52 +220,60 @@ bool operator==(const Vector& v, const Vector& w)
     return true;
 }
 
-bool operator!=(const Vector& v, const Vector& w)
+template <typename T>
+bool operator!=(const BasicVector<T>& v, const BasicVector<T>& w)
 {
     return !(v == w);
 }
 
-Vector operator+(const Vector& v, const Vector& w)
+template <typename T>
+BasicVector<T> operator+(const BasicVector<T>& v, const BasicVector<T>& w)
 {
-    return Vector(v) += w;
+    BasicVector<T> result(v);
+    result += w;
+    return result;
 }
 
-Vector operator-(const Vector& v, const Vector& w)
+template <typename T>
+BasicVector<T> operator-(const BasicVector<T>& v, const BasicVector<T>& w)
 {
-    return Vector(v) -= w;
+    BasicVector<T> result(v);
+    result -= w;
+    return result;
 }
 
-Vector operator*(const Vector& v, float x)
+template <typename T>
+BasicVector<T> operator*(const BasicVector<T>& v,
+                         typename BasicVector<T>::value_type x)
 {
-    return Vector(v) *= x;
+    BasicVector<T> result(v);
+    result *= x;
+    return result;
 }
 
-Vector operator*(float x, const Vector& v)
+template <typename T>
+BasicVector<T> operator*(typename BasicVector<T>::value_type x,
+                         const BasicVector<T>& v)
 {
-    return Vector(v) *= x;
+    BasicVector<T> result(v);
+    result *= x;
+    return result;
 }
 
-std::ostream& operator<<(std::ostream& os, const Vector& v)
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicVector<T>& v)
 {
-    os << "(";
-    for (int i = 0; i < v.size(); ++i)
-    {
-        os << (i > 0 ? ", " : "") << v[i];
-    }
-    os << ")";
+    print(os, v);
     return os;
 }
 
-Vector round(const Vector& v, float epsilon)
+template <typename T>
+BasicVector<T> round(const BasicVector<T>& v, RealType<T> epsilon)
 {
-    Vector w(v);
-    for (float& entry : w)
+    BasicVector<T> w(v);
+    for (T& entry : w)
     {
-        float rounded = std::round(entry);  // to nearest integer
-        if (rounded == -0.0F)
-        {
-            rounded = 0.0F;
-        }
+        T rounded = roundScalar(entry);
         if (approxEqual(entry, rounded, epsilon))
         {
             entry = rounded;
@@ -221,43 +282,37 @@ Vector round(const Vector& v, float epsilon)
     return w;
 }
 
-bool approxEqual(const Vector& v, const Vector& w, float epsilon)
+template <typename T>
+bool approxEqual(const BasicVector<T>& v, const BasicVector<T>& w,
+                 RealType<T> epsilon)
 {
     if (&v == &w)
     {
         return true;
     }
-    if (v.size() != w.size())
-    {
-        return false;
-    }
-    for (int i = 0; i < v.size(); ++i)
-    {
-        if (!approxEqual(v[i], w[i], epsilon))
-        {
-            return false;
-        }
-    }
-    return true;
+    return approxEqual(static_cast<const BasicConstVectorView<T>&>(v), w,
+                       epsilon);
 }
 
-Vector homogenize(const Vector& v)
+template <typename T>
+BasicVector<T> homogenize(const BasicVector<T>& v)
 {
     int n = v.size();
-    Vector w(n + 1);
+    BasicVector<T> w(n + 1);
     for (int i = 0; i < n; ++i)
     {
         w[i] = v[i];
     }
-    w[n] = 1.0F;
+    w[n] = T(1);
     return w;
 }
 
-Vector dehomogenize(const Vector& v)
+template <typename T>
+BasicVector<T> dehomogenize(const BasicVector<T>& v)
 {
     int n = v.size();
-    assert(n > 0 && v[n - 1] != 0.0F);
-    Vector w(n - 1);
+    assert(n > 0 && v[n - 1] != T(0));
+    BasicVector<T> w(n - 1);
     for (int i = 0; i < n - 1; ++i)
     {
         w[i] = v[i] / v[n - 1];
@@ -265,4 +320,28 @@ Vector dehomogenize(const Vector& v)
     return w;
 }
 
-}  // namespace la
\ No newline at end of file
+#define LA_INSTANTIATE_VECTOR(T)                                              \
+    template class BasicVector<T>;                                            \
+    template bool operator==(const BasicVector<T>&, const BasicVector<T>&);   \
+    template bool operator!=(const BasicVector<T>&, const BasicVector<T>&);   \
+    template BasicVector<T> operator+(const BasicVector<T>&,                  \
+                                      const BasicVector<T>&);                 \
+    template BasicVector<T> operator-(const BasicVector<T>&,                  \
+                                      const BasicVector<T>&);                 \
+    template BasicVector<T> operator*(const BasicVector<T>&, T);              \
+    template BasicVector<T> operator*(T, const BasicVector<T>&);              \
+    template std::ostream& operator<<(std::ostream&, const BasicVector<T>&);  \
+    template BasicVector<T> round(const BasicVector<T>&, RealType<T>);        \
+    template bool approxEqual(const BasicVector<T>&, const BasicVector<T>&,   \
+                              RealType<T>);                                   \
+    template BasicVector<T> homogenize(const BasicVector<T>&);                \
+    template BasicVector<T> dehomogenize(const BasicVector<T>&);
+
+LA_INSTANTIATE_VECTOR(float)
+LA_INSTANTIATE_VECTOR(double)
+LA_INSTANTIATE_VECTOR(std::complex<float>)
+LA_INSTANTIATE_VECTOR(std::complex<double>)
+
+#undef LA_INSTANTIATE_VECTOR
+
+}  // namespace la
@@ -0,0 +1,749 @@
+#include "inc/view.h"
+#include "inc/instrument.h"
+#include "inc/util.h"
+#include <algorithm>  // min()
+#include <cassert>
+#include <complex>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace la
+{
+
+template <typename T>
+BasicConstVectorView<T>::BasicConstVectorView(const T* p, int n, int inc)
+: _p{const_cast<T*>(p)},
+  _n{n},
+  _inc{inc}
+{
+    assert(n >= 0 && inc > 0);
+}
+
+template <typename T>
+const T& BasicConstVectorView<T>::operator[](int i) const
+{
+    assert(i >= 0 && i < _n);
+    return _p[i * _inc];
+}
+
+template <typename T>
+const T* BasicConstVectorView<T>::data() const
+{
+    return _p;
+}
+
+template <typename T>
+int BasicConstVectorView<T>::size() const
+{
+    return _n;
+}
+
+template <typename T>
+int BasicConstVectorView<T>::stride() const
+{
+    return _inc;
+}
+
+template <typename T>
+BasicVectorView<T>::BasicVectorView(T* p, int n, int inc)
+: BasicConstVectorView<T>(p, n, inc)
+{}
+
+template <typename T>
+T& BasicVectorView<T>::operator[](int i) const
+{
+    assert(i >= 0 && i < this->_n);
+    return this->_p[i * this->_inc];
+}
+
+template <typename T>
+T* BasicVectorView<T>::data() const
+{
+    return this->_p;
+}
+
+template <typename T>
+BasicConstMatrixView<T>::BasicConstMatrixView(const T* p, int m, int n,
+                                              int ld)
+: _p{const_cast<T*>(p)},
+  _m{m},
+  _n{n},
+  _ld{ld}
+{
+    assert(m >= 0 && n >= 0 && ld >= m && ld > 0);
+}
+
+template <typename T>
+const T& BasicConstMatrixView<T>::operator()(int i, int j) const
+{
+    assert(i >= 0 && i < _m && j >= 0 && j < _n);
+    return _p[i + j * _ld];
+}
+
+template <typename T>
+const T* BasicConstMatrixView<T>::data() const
+{
+    return _p;
+}
+
+template <typename T>
+int BasicConstMatrixView<T>::rows() const
+{
+    return _m;
+}
+
+template <typename T>
+int BasicConstMatrixView<T>::cols() const
+{
+    return _n;
+}
+
+template <typename T>
+int BasicConstMatrixView<T>::ld() const
+{
+    return _ld;
+}
+
+/**
+ * Returns a view of the m x n block whose top left entry is (i, j).
+ */
+template <typename T>
+BasicConstMatrixView<T> BasicConstMatrixView<T>::block(int i, int j, int m,
+                                                       int n) const
+{
+    assert(i >= 0 && m >= 0 && i + m <= _m);
+    assert(j >= 0 && n >= 0 && j + n <= _n);
+    return {_p + i + j * _ld, m, n, _ld};
+}
+
+template <typename T>
+BasicConstVectorView<T> BasicConstMatrixView<T>::row(int i) const
+{
+    assert(i >= 0 && i < _m);
+    return {_p + i, _n, _ld};
+}
+
+template <typename T>
+BasicConstVectorView<T> BasicConstMatrixView<T>::col(int j) const
+{
+    assert(j >= 0 && j < _n);
+    return {_p + j * _ld, _m, 1};
+}
+
+template <typename T>
+BasicConstVectorView<T> BasicConstMatrixView<T>::diag() const
+{
+    return {_p, std::min(_m, _n), _ld + 1};
+}
+
+template <typename T>
+BasicMatrixView<T>::BasicMatrixView(T* p, int m, int n, int ld)
+: BasicConstMatrixView<T>(p, m, n, ld)
+{}
+
+template <typename T>
+T& BasicMatrixView<T>::operator()(int i, int j) const
+{
+    assert(i >= 0 && i < this->_m && j >= 0 && j < this->_n);
+    return this->_p[i + j * this->_ld];
+}
+
+template <typename T>
+T* BasicMatrixView<T>::data() const
+{
+    return this->_p;
+}
+
+template <typename T>
+BasicMatrixView<T> BasicMatrixView<T>::block(int i, int j, int m, int n) const
+{
+    assert(i >= 0 && m >= 0 && i + m <= this->_m);
+    assert(j >= 0 && n >= 0 && j + n <= this->_n);
+    return {this->_p + i + j * this->_ld, m, n, this->_ld};
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrixView<T>::row(int i) const
+{
+    assert(i >= 0 && i < this->_m);
+    return {this->_p + i, this->_n, this->_ld};
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrixView<T>::col(int j) const
+{
+    assert(j >= 0 && j < this->_n);
+    return {this->_p + j * this->_ld, this->_m, 1};
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrixView<T>::diag() const
+{
+    return {this->_p, std::min(this->_m, this->_n), this->_ld + 1};
+}
+
+template <typename T>
+void copy(const BasicConstVectorView<T>& x, const BasicVectorView<T>& y)
+{
+    assert(x.size() == y.size());
+    const T* xp = x.data();
+    T* yp = y.data();
+    for (int i = 0, n = x.size(); i < n; ++i)
+    {
+        yp[i * y.stride()] = xp[i * x.stride()];
+    }
+}
+
+template <typename T>
+void copy(const BasicConstMatrixView<T>& A, const BasicMatrixView<T>& B)
+{
+    assert(A.rows() == B.rows() && A.cols() == B.cols());
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        const T* a = A.data() + j * A.ld();
+        T* b = B.data() + j * B.ld();
+        std::copy(a, a + A.rows(), b);
+    }
+}
+
+template <typename T>
+void fill(const BasicVectorView<T>& x,
+          typename BasicVectorView<T>::value_type value)
+{
+    T* xp = x.data();
+    for (int i = 0, n = x.size(); i < n; ++i)
+    {
+        xp[i * x.stride()] = value;
+    }
+}
+
+template <typename T>
+void fill(const BasicMatrixView<T>& A,
+          typename BasicMatrixView<T>::value_type value)
+{
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        T* a = A.data() + j * A.ld();
+        std::fill(a, a + A.rows(), value);
+    }
+}
+
+template <typename T>
+void scale(typename BasicVectorView<T>::value_type alpha,
+           const BasicVectorView<T>& x)
+{
+    T* xp = x.data();
+    for (int i = 0, n = x.size(); i < n; ++i)
+    {
+        xp[i * x.stride()] *= alpha;
+    }
+}
+
+template <typename T>
+void scale(typename BasicMatrixView<T>::value_type alpha,
+           const BasicMatrixView<T>& A)
+{
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        T* a = A.data() + j * A.ld();
+        for (int i = 0; i < A.rows(); ++i)
+        {
+            a[i] *= alpha;
+        }
+    }
+}
+
+/**
+ * Computes y = alpha x + y.
+ */
+template <typename T>
+void axpy(typename BasicVectorView<T>::value_type alpha,
+          const BasicConstVectorView<T>& x, const BasicVectorView<T>& y)
+{
+    assert(x.size() == y.size());
+    const T* xp = x.data();
+    T* yp = y.data();
+    for (int i = 0, n = x.size(); i < n; ++i)
+    {
+        yp[i * y.stride()] += alpha * xp[i * x.stride()];
+    }
+}
+
+/**
+ * Returns the unconjugated dot product of x and y.
+ */
+template <typename T>
+T dot(const BasicConstVectorView<T>& x, const BasicConstVectorView<T>& y)
+{
+    assert(x.size() == y.size());
+    const T* xp = x.data();
+    const T* yp = y.data();
+    T sum = T(0);
+    for (int i = 0, n = x.size(); i < n; ++i)
+    {
+        sum += xp[i * x.stride()] * yp[i * y.stride()];
+    }
+    return sum;
+}
+
+/**
+ * Computes y = alpha A x + beta y, sweeping A one column at a time.
+ * y must not overlap A or x.
+ */
+template <typename T>
+void gemv(typename BasicVectorView<T>::value_type alpha,
+          const BasicConstMatrixView<T>& A, const BasicConstVectorView<T>& x,
+          typename BasicVectorView<T>::value_type beta,
+          const BasicVectorView<T>& y)
+{
+    assert(A.cols() == x.size() && A.rows() == y.size());
+    LA_PROFILE("gemv", 2.0 * A.rows() * A.cols(),
+               (1.0 * A.rows() * A.cols() + x.size() + 2.0 * y.size())
+                   * sizeof(T));
+    if (beta == T(0))
+    {
+        fill(y, T(0));
+    }
+    else if (beta != T(1))
+    {
+        scale(beta, y);
+    }
+    T* yp = y.data();
+    int inc = y.stride();
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        const T* a = A.data() + j * A.ld();
+        T axj = alpha * x[j];
+        for (int i = 0; i < A.rows(); ++i)
+        {
+            yp[i * inc] += a[i] * axj;
+        }
+    }
+}
+
+/**
+ * Computes C = alpha op(A) op(B) + beta C, where op(X) is X or X^T as given
+ * by opA and opB. Operands are read in place, so no transposed copies are
+ * made. C must not overlap A or B. When beta is zero, C is not read.
+ */
+template <typename T>
+void gemm(Op opA, Op opB, typename BasicMatrixView<T>::value_type alpha,
+          const BasicConstMatrixView<T>& A, const BasicConstMatrixView<T>& B,
+          typename BasicMatrixView<T>::value_type beta,
+          const BasicMatrixView<T>& C)
+{
+    bool ta = (opA == Op::Trans);
+    bool tb = (opB == Op::Trans);
+    int m = C.rows();
+    int n = C.cols();
+    int k = ta ? A.rows() : A.cols();
+    assert((ta ? A.cols() : A.rows()) == m);
+    assert((tb ? B.rows() : B.cols()) == n);
+    assert((tb ? B.cols() : B.rows()) == k);
+    LA_PROFILE("gemm", 2.0 * m * n * k,
+               (1.0 * m * k + 1.0 * k * n + 2.0 * m * n) * sizeof(T));
+
+    const T* a = A.data();
+    const T* b = B.data();
+    int lda = A.ld();
+    int ldb = B.ld();
+    for (int j = 0; j < n; ++j)
+    {
+        T* c = C.data() + j * C.ld();
+        if (ta)
+        {
+            // Each entry of C is a dot product with a contiguous column of A.
+            for (int i = 0; i < m; ++i)
+            {
+                const T* ai = a + i * lda;
+                T sum = T(0);
+                for (int p = 0; p < k; ++p)
+                {
+                    sum += ai[p] * (tb ? b[j + p * ldb] : b[p + j * ldb]);
+                }
+                c[i] = (beta == T(0)) ? alpha * sum : alpha * sum + beta * c[i];
+            }
+            continue;
+        }
+
+        // Column j of C accumulates the columns of A weighted by op(B)(:, j).
+        if (beta == T(0))
+        {
+            std::fill(c, c + m, T(0));
+        }
+        else if (beta != T(1))
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                c[i] *= beta;
+            }
+        }
+        for (int p = 0; p < k; ++p)
+        {
+            T bpj = alpha * (tb ? b[j + p * ldb] : b[p + j * ldb]);
+            const T* ap = a + p * lda;
+            for (int i = 0; i < m; ++i)
+            {
+                c[i] += ap[i] * bpj;
+            }
+        }
+    }
+}
+
+namespace
+{
+
+/**
+ * Entries compared between checks for a mismatch. Within a block the
+ * comparisons are branch-free, so they vectorize, while a mismatch still
+ * ends a long comparison early.
+ */
+const int COMPARE_BLOCK = 256;
+
+// True if the n entries at x and y are pairwise approxEqual().
+template <typename T>
+bool approxEqualRun(const T* x, const T* y, int n, RealType<T> epsilon)
+{
+    for (int lo = 0; lo < n; lo += COMPARE_BLOCK)
+    {
+        int hi = std::min(n, lo + COMPARE_BLOCK);
+        bool equal = true;
+        for (int i = lo; i < hi; ++i)
+        {
+            equal &= approxEqual(x[i], y[i], epsilon);
+        }
+        if (!equal)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(__SSE2__)
+// Four entries at a time; a lane is unequal if !(|x - y| < tolerance),
+// which also catches NaNs.
+template <>
+bool approxEqualRun(const float* x, const float* y, int n, float epsilon)
+{
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 eps = _mm_set1_ps(epsilon);
+    int i = 0;
+    while (i + 4 <= n)
+    {
+        int hi = std::min(i + COMPARE_BLOCK, n - n % 4);
+        __m128 unequal = _mm_setzero_ps();
+        for (; i < hi; i += 4)
+        {
+            __m128 a = _mm_loadu_ps(x + i);
+            __m128 b = _mm_loadu_ps(y + i);
+            __m128 d = _mm_and_ps(mask, _mm_sub_ps(a, b));
+            __m128 s = _mm_add_ps(_mm_and_ps(mask, a), _mm_and_ps(mask, b));
+            __m128 tol = _mm_mul_ps(_mm_add_ps(s, one), eps);
+            unequal = _mm_or_ps(unequal, _mm_cmpnlt_ps(d, tol));
+        }
+        if (_mm_movemask_ps(unequal) != 0)
+        {
+            return false;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if (!approxEqual(x[i], y[i], epsilon))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <>
+bool approxEqualRun(const double* x, const double* y, int n, double epsilon)
+{
+    const __m128d mask = _mm_castsi128_pd(
+        _mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d eps = _mm_set1_pd(epsilon);
+    int i = 0;
+    while (i + 2 <= n)
+    {
+        int hi = std::min(i + COMPARE_BLOCK, n - n % 2);
+        __m128d unequal = _mm_setzero_pd();
+        for (; i < hi; i += 2)
+        {
+            __m128d a = _mm_loadu_pd(x + i);
+            __m128d b = _mm_loadu_pd(y + i);
+            __m128d d = _mm_and_pd(mask, _mm_sub_pd(a, b));
+            __m128d s = _mm_add_pd(_mm_and_pd(mask, a), _mm_and_pd(mask, b));
+            __m128d tol = _mm_mul_pd(_mm_add_pd(s, one), eps);
+            unequal = _mm_or_pd(unequal, _mm_cmpnlt_pd(d, tol));
+        }
+        if (_mm_movemask_pd(unequal) != 0)
+        {
+            return false;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if (!approxEqual(x[i], y[i], epsilon))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+// True if the n entries at x and y are pairwise within maxUlps.
+template <typename T>
+bool ulpsEqualRun(const T* x, const T* y, int n, std::uint64_t maxUlps)
+{
+    for (int lo = 0; lo < n; lo += COMPARE_BLOCK)
+    {
+        int hi = std::min(n, lo + COMPARE_BLOCK);
+        bool equal = true;
+        for (int i = lo; i < hi; ++i)
+        {
+            equal &= ulpDistance(x[i], y[i]) <= maxUlps;
+        }
+        if (!equal)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The largest of e and the errors |x - y| / (|x| + |y| + 1) of the n
+ * entries at x and y: the least epsilon for which approxEqual() would
+ * fail. A NaN error is the largest of all.
+ */
+template <typename T>
+RealType<T> maxErrorRun(const T* x, const T* y, int n, RealType<T> e)
+{
+    using std::abs;
+    for (int i = 0; i < n; ++i)
+    {
+        RealType<T> ei = abs(x[i] - y[i]) / (abs(x[i]) + abs(y[i]) + 1);
+        e = (ei > e || ei != ei) ? ei : e;
+    }
+    return e;
+}
+
+template <typename T>
+std::uint64_t maxUlpRun(const T* x, const T* y, int n, std::uint64_t d)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        std::uint64_t di = ulpDistance(x[i], y[i]);
+        d = (di > d) ? di : d;
+    }
+    return d;
+}
+
+/**
+ * Applies the run kernel f(x, y, n) to the entries of x and y, one at a
+ * time unless both are contiguous, stopping at the first run for which
+ * it returns false.
+ */
+template <typename T, typename F>
+bool allRuns(const BasicConstVectorView<T>& x,
+             const BasicConstVectorView<T>& y, F f)
+{
+    if (x.stride() == 1 && y.stride() == 1)
+    {
+        return f(x.data(), y.data(), x.size());
+    }
+    for (int i = 0; i < x.size(); ++i)
+    {
+        if (!f(&x[i], &y[i], 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Applies the run kernel f to each pair of columns of A and B.
+template <typename T, typename F>
+bool allRuns(const BasicConstMatrixView<T>& A,
+             const BasicConstMatrixView<T>& B, F f)
+{
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        if (!f(A.data() + j * A.ld(), B.data() + j * B.ld(), A.rows()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+template <typename T>
+bool approxEqual(const BasicConstVectorView<T>& x,
+                 const BasicConstVectorView<T>& y, RealType<T> epsilon)
+{
+    return x.size() == y.size()
+           && allRuns(x, y, [epsilon](const T* a, const T* b, int n)
+           {
+               return approxEqualRun(a, b, n, epsilon);
+           });
+}
+
+template <typename T>
+bool approxEqual(const BasicConstMatrixView<T>& A,
+                 const BasicConstMatrixView<T>& B, RealType<T> epsilon)
+{
+    return A.rows() == B.rows() && A.cols() == B.cols()
+           && allRuns(A, B, [epsilon](const T* a, const T* b, int n)
+           {
+               return approxEqualRun(a, b, n, epsilon);
+           });
+}
+
+/**
+ * Returns true if x and y have the same size and each pair of entries is
+ * at most maxUlps representable values apart (see ulpDistance()).
+ */
+template <typename T>
+bool approxEqualUlps(const BasicConstVectorView<T>& x,
+                     const BasicConstVectorView<T>& y, std::uint64_t maxUlps)
+{
+    return x.size() == y.size()
+           && allRuns(x, y, [maxUlps](const T* a, const T* b, int n)
+           {
+               return ulpsEqualRun(a, b, n, maxUlps);
+           });
+}
+
+template <typename T>
+bool approxEqualUlps(const BasicConstMatrixView<T>& A,
+                     const BasicConstMatrixView<T>& B, std::uint64_t maxUlps)
+{
+    return A.rows() == B.rows() && A.cols() == B.cols()
+           && allRuns(A, B, [maxUlps](const T* a, const T* b, int n)
+           {
+               return ulpsEqualRun(a, b, n, maxUlps);
+           });
+}
+
+/**
+ * Returns the largest error |x[i] - y[i]| / (|x[i]| + |y[i]| + 1) of the
+ * entries of x and y, which must have the same size: approxEqual(x, y,
+ * epsilon) holds exactly when epsilon exceeds it. NaN if any error is NaN.
+ */
+template <typename T>
+RealType<T> maxError(const BasicConstVectorView<T>& x,
+                     const BasicConstVectorView<T>& y)
+{
+    assert(x.size() == y.size());
+    RealType<T> e = 0;
+    allRuns(x, y, [&e](const T* a, const T* b, int n)
+    {
+        e = maxErrorRun(a, b, n, e);
+        return true;
+    });
+    return e;
+}
+
+template <typename T>
+RealType<T> maxError(const BasicConstMatrixView<T>& A,
+                     const BasicConstMatrixView<T>& B)
+{
+    assert(A.rows() == B.rows() && A.cols() == B.cols());
+    RealType<T> e = 0;
+    allRuns(A, B, [&e](const T* a, const T* b, int n)
+    {
+        e = maxErrorRun(a, b, n, e);
+        return true;
+    });
+    return e;
+}
+
+/**
+ * Returns the largest ulpDistance() between entries of x and y, which
+ * must have the same size.
+ */
+template <typename T>
+std::uint64_t maxUlpDistance(const BasicConstVectorView<T>& x,
+                             const BasicConstVectorView<T>& y)
+{
+    assert(x.size() == y.size());
+    std::uint64_t d = 0;
+    allRuns(x, y, [&d](const T* a, const T* b, int n)
+    {
+        d = maxUlpRun(a, b, n, d);
+        return true;
+    });
+    return d;
+}
+
+template <typename T>
+std::uint64_t maxUlpDistance(const BasicConstMatrixView<T>& A,
+                             const BasicConstMatrixView<T>& B)
+{
+    assert(A.rows() == B.rows() && A.cols() == B.cols());
+    std::uint64_t d = 0;
+    allRuns(A, B, [&d](const T* a, const T* b, int n)
+    {
+        d = maxUlpRun(a, b, n, d);
+        return true;
+    });
+    return d;
+}
+
+#define LA_INSTANTIATE_VIEW(T)                                                \
+    template class BasicConstVectorView<T>;                                   \
+    template class BasicVectorView<T>;                                        \
+    template class BasicConstMatrixView<T>;                                   \
+    template class BasicMatrixView<T>;                                        \
+    template void copy(const BasicConstVectorView<T>&,                        \
+                       const BasicVectorView<T>&);                            \
+    template void copy(const BasicConstMatrixView<T>&,                        \
+                       const BasicMatrixView<T>&);                            \
+    template void fill(const BasicVectorView<T>&, T);                         \
+    template void fill(const BasicMatrixView<T>&, T);                         \
+    template void scale(T, const BasicVectorView<T>&);                        \
+    template void scale(T, const BasicMatrixView<T>&);                        \
+    template void axpy(T, const BasicConstVectorView<T>&,                     \
+                       const BasicVectorView<T>&);                            \
+    template T dot(const BasicConstVectorView<T>&,                            \
+                   const BasicConstVectorView<T>&);                           \
+    template void gemv(T, const BasicConstMatrixView<T>&,                     \
+                       const BasicConstVectorView<T>&, T,                     \
+                       const BasicVectorView<T>&);                            \
+    template void gemm(Op, Op, T, const BasicConstMatrixView<T>&,             \
+                       const BasicConstMatrixView<T>&, T,                     \
+                       const BasicMatrixView<T>&);                            \
+    template bool approxEqual(const BasicConstVectorView<T>&,                 \
+                              const BasicConstVectorView<T>&, RealType<T>);   \
+    template bool approxEqual(const BasicConstMatrixView<T>&,                 \
+                              const BasicConstMatrixView<T>&, RealType<T>);   \
+    template bool approxEqualUlps(const BasicConstVectorView<T>&,             \
+                                  const BasicConstVectorView<T>&,             \
+                                  std::uint64_t);                             \
+    template bool approxEqualUlps(const BasicConstMatrixView<T>&,             \
+                                  const BasicConstMatrixView<T>&,             \
+                                  std::uint64_t);                             \
+    template RealType<T> maxError(const BasicConstVectorView<T>&,             \
+                                  const BasicConstVectorView<T>&);            \
+    template RealType<T> maxError(const BasicConstMatrixView<T>&,             \
+                                  const BasicConstMatrixView<T>&);            \
+    template std::uint64_t maxUlpDistance(const BasicConstVectorView<T>&,     \
+                                          const BasicConstVectorView<T>&);    \
+    template std::uint64_t maxUlpDistance(const BasicConstMatrixView<T>&,     \
+                                          const BasicConstMatrixView<T>&);
+
+LA_INSTANTIATE_VIEW(float)
+LA_INSTANTIATE_VIEW(double)
+LA_INSTANTIATE_VIEW(std::complex<float>)
+LA_INSTANTIATE_VIEW(std::complex<double>)
+
+#undef LA_INSTANTIATE_VIEW
+
+}  // namespace la
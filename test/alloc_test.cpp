@@ -0,0 +1,72 @@
+#include "inc/catch.h"
+#include "inc/alloc.h"
+#include "inc/gauss.h"
+#include "inc/matrix.h"
+#include "inc/vector.h"
+
+TEST_CASE("alloc: workspace releases on scope exit", "[alloc]")
+{
+    std::size_t before = la::Workspace::used();
+    {
+        la::Workspace ws;
+        la::Matrix A(10, 10, 1.0F);
+        la::Vector x(10, 2.0F);
+        REQUIRE(la::Workspace::used() > before);
+        REQUIRE(A * x == la::Vector(10, 20.0F));
+    }
+    REQUIRE(la::Workspace::used() == before);
+}
+
+TEST_CASE("alloc: temporaries reuse the most recent allocation", "[alloc]")
+{
+    la::Workspace ws;
+    la::Vector x(100, 1.0F);
+    std::size_t used = la::Workspace::used();
+    for (int i = 0; i < 10; ++i)
+    {
+        x = x + x;
+    }
+    REQUIRE(la::Workspace::used() == used);
+    REQUIRE(x[0] == 1024.0F);
+}
+
+TEST_CASE("alloc: steady state does not touch the heap", "[alloc]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            { 4, -2,  1},
+            {-2,  4, -2},
+            { 1, -2,  4}
+        });
+    auto solve = [&A](la::Vector& x)
+    {
+        la::Workspace ws;
+        la::Matrix B = A * A + A;
+        la::Matrix C = la::augment(B, la::Matrix::identity(3));
+        la::eliminate(C, la::partialPivotSelector);
+        la::copy(C.col(3), x);
+    };
+
+    // The first round may size the arena; it must not grow afterwards.
+    la::Vector first(3);
+    la::Vector second(3);
+    solve(first);
+    std::size_t heap = la::heapAllocations();
+    solve(second);
+    REQUIRE(la::heapAllocations() == heap);
+    REQUIRE(second == first);
+}
+
+TEST_CASE("alloc: nested workspaces", "[alloc]")
+{
+    la::Workspace outer;
+    la::Vector x(1000, 1.0F);
+    std::size_t used = la::Workspace::used();
+    {
+        la::Workspace inner;
+        la::Matrix A(100, 100, 0.0F);
+        REQUIRE(la::Workspace::used() > used);
+    }
+    REQUIRE(la::Workspace::used() == used);
+    REQUIRE(x[999] == 1.0F);
+}
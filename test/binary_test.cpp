@@ -0,0 +1,86 @@
+#include "inc/catch.h"
+#include "inc/binary.h"
+#include "inc/matrix.h"
+#include <complex>
+#include <cstdint>
+#include <cstdio>  // remove()
+#include <fstream>
+#include <utility>  // move()
+#include <unistd.h>  // truncate()
+
+TEST_CASE("binary: write and map a matrix", "[binary]")
+{
+    la::Matrix A = la::Matrix::random(130, 3);
+    const char* path = "binary_test.lam";
+    REQUIRE(la::writeBinary(path, A));
+
+    la::MappedMatrix M;
+    REQUIRE_FALSE(M.isOpen());
+    REQUIRE(M.open(path, true));
+    REQUIRE(M.isOpen());
+    REQUIRE(M.rows() == 130);
+    REQUIRE(M.cols() == 3);
+    REQUIRE(M.ld() == A.ld());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(M.data()) % 64 == 0);
+    REQUIRE(la::Matrix(M) == A);
+
+    // Moving hands over the mapping.
+    la::MappedMatrix N = std::move(M);
+    REQUIRE_FALSE(M.isOpen());
+    REQUIRE(N(129, 2) == A(129, 2));
+    N.close();
+    REQUIRE(N.rows() == 0);
+    std::remove(path);
+}
+
+TEST_CASE("binary: blocks and complex entries", "[binary]")
+{
+    la::BasicMatrix<std::complex<double>> A(4, 4);
+    for (int j = 0; j < 4; ++j)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            A(i, j) = {1.0 * i, 1.0 * j};
+        }
+    }
+    const char* path = "binary_test.lam";
+    REQUIRE(la::writeBinary(path, A.block(1, 2, 3, 2)));
+
+    la::BasicMappedMatrix<std::complex<double>> M;
+    REQUIRE(M.open(path, true));
+    REQUIRE(M.rows() == 3);
+    REQUIRE(M.cols() == 2);
+    REQUIRE(M(0, 0) == std::complex<double>(1, 2));
+    REQUIRE(M(2, 1) == std::complex<double>(3, 3));
+
+    // The type of the entries must match.
+    la::BasicMappedMatrix<double> D;
+    REQUIRE_FALSE(D.open(path));
+    std::remove(path);
+}
+
+TEST_CASE("binary: damaged files are rejected", "[binary]")
+{
+    la::Matrix A(8, 8, 1.0F);
+    const char* path = "binary_test.lam";
+    REQUIRE(la::writeBinary(path, A));
+    {
+        // Flip an entry behind the header.
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(64 + 5 * sizeof(float));
+        float x = 2.0F;
+        f.write(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+    la::MappedMatrix M;
+    REQUIRE(M.open(path));
+    REQUIRE(M(5, 0) == 2.0F);
+    REQUIRE_FALSE(M.open(path, true));
+    REQUIRE_FALSE(M.isOpen());
+
+    // A file too short for its shape.
+    REQUIRE(::truncate(path, 64 + 10) == 0);
+    REQUIRE_FALSE(M.open(path));
+    std::remove(path);
+
+    REQUIRE_FALSE(M.open("no_such_file.lam"));
+}
@@ -0,0 +1,71 @@
+#include "inc/catch.h"
+#include "inc/fixed.h"
+
+TEST_CASE("fixed: vector arithmetic", "[fixed]")
+{
+    la::FixedVector<3> a1{1, 2, -1};
+    la::FixedVector<3> a2{2, 3,  6};
+    la::FixedVector<3> b{2, 1, 22};
+    REQUIRE(-4.0F * a1 + 3.0F * a2 == b);
+    REQUIRE(la::dot(a1, a2) == 2);
+    REQUIRE(la::FixedVector<3>::size() == 3);
+    static_assert(sizeof(la::FixedVector<4>) == 4 * sizeof(float),
+                  "FixedVector must store its entries inline");
+}
+
+TEST_CASE("fixed: homogeneous coordinates", "[fixed]")
+{
+    la::FixedVector<3> v{5, -3, 7};
+    REQUIRE(la::homogenize(v) == la::FixedVector<4>{5, -3, 7, 1});
+    REQUIRE(la::dehomogenize(la::FixedVector<4>{10, -6, 14, 2}) == v);
+}
+
+TEST_CASE("fixed: matrix products", "[fixed]")
+{
+    la::FixedMatrix<2, 2> A = la::FixedMatrix<2, 2>::fromRows(
+        {
+            {2,  3},
+            {1, -5}
+        });
+    la::FixedMatrix<2, 3> B = la::FixedMatrix<2, 3>::fromRows(
+        {
+            {4,  3, 6},
+            {1, -2, 3}
+        });
+    REQUIRE(A * B == la::FixedMatrix<2, 3>::fromRows(
+        {
+            {11,  0, 21},
+            {-1, 13, -9}
+        }));
+    REQUIRE(la::transpose(A * B) == la::transpose(B) * la::transpose(A));
+    REQUIRE(A * la::FixedMatrix<2, 2>::identity() == A);
+}
+
+TEST_CASE("fixed: transform of a point", "[fixed]")
+{
+    // Scale by 2, then translate by (1, 2, 3).
+    la::FixedMatrix<4, 4> M = la::FixedMatrix<4, 4>::fromRows(
+        {
+            {2, 0, 0, 1},
+            {0, 2, 0, 2},
+            {0, 0, 2, 3},
+            {0, 0, 0, 1}
+        });
+    la::FixedVector<3> p{1, 1, 1};
+    REQUIRE(la::dehomogenize(M * la::homogenize(p))
+            == la::FixedVector<3>{3, 4, 5});
+}
+
+TEST_CASE("fixed: interoperates with dynamic types", "[fixed]")
+{
+    la::Matrix D = la::Matrix::fromRows(
+        {
+            {1, 2, 3},
+            {4, 5, 6}
+        });
+    la::FixedMatrix<2, 3> F(D);
+    REQUIRE(F.toMatrix() == D);
+    la::Vector x{1, 0, -1};
+    REQUIRE((F * la::FixedVector<3>(x)).toVector() == D * x);
+    REQUIRE(la::approxEqual(F, la::FixedMatrix<2, 3>(D)));
+}
@@ -0,0 +1,88 @@
+#include "inc/catch.h"
+#include "inc/format.h"
+#include "inc/matrix.h"
+#include "inc/vector.h"
+#include <algorithm>  // count()
+#include <complex>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+template <typename T>
+std::string str(const T& x)
+{
+    std::ostringstream oss;
+    oss << x;
+    return oss.str();
+}
+
+}  // namespace
+
+TEST_CASE("format: scalars use the shortest round-trip text", "[format]")
+{
+    char s[la::MAX_SCALAR_CHARS];
+    char* last = s + la::MAX_SCALAR_CHARS;
+    REQUIRE(std::string(s, la::formatScalar(s, last, 0.1)) == "0.1");
+    REQUIRE(std::string(s, la::formatScalar(s, last, 1.0F / 3))
+            == "0.33333334");
+    REQUIRE(std::string(s, la::formatScalar(s, last, -2.0)) == "-2");
+    REQUIRE(std::string(s, la::formatScalar(s, last,
+                                            std::complex<float>(1, -0.5F)))
+            == "(1,-0.5)");
+
+    double x = 2.0 / 3;
+    REQUIRE(std::strtod(std::string(s, la::formatScalar(s, last, x)).c_str(),
+                        nullptr)
+            == x);
+}
+
+TEST_CASE("format: vectors and aligned matrices", "[format]")
+{
+    REQUIRE(str(la::Vector{1, 2.5F, -3}) == "(1, 2.5, -3)");
+
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            { 1, -2.5F},
+            {10,  0.1F}
+        });
+    REQUIRE(str(A) == "(( 1, -2.5)\n"
+                      " (10,  0.1))\n");
+}
+
+TEST_CASE("format: head and tail rows", "[format]")
+{
+    la::Matrix A(5, 2);
+    for (int i = 0; i < 5; ++i)
+    {
+        A(i, 0) = i;
+        A(i, 1) = -100 * (i == 2);
+    }
+
+    // Widths come from the written rows only.
+    std::ostringstream oss;
+    la::print(oss, A, {2, 1});
+    REQUIRE(oss.str() == "((0, 0)\n"
+                         " (1, 0)\n"
+                         " ...\n"
+                         " (4, 0))\n");
+
+    oss.str("");
+    la::print(oss, A, {0, 0});
+    REQUIRE(oss.str() == "(...)\n");
+
+    // Nothing is elided when every row fits.
+    oss.str("");
+    la::print(oss, A, {3, 2});
+    REQUIRE(oss.str() == str(A));
+}
+
+TEST_CASE("format: wide matrices stream out", "[format]")
+{
+    la::Matrix A(2, 100000, 1.0F);
+    std::string s = str(A);
+    REQUIRE(std::count(s.begin(), s.end(), '1') == 200000);
+    REQUIRE(s.substr(s.size() - 4) == "1))\n");
+}
@@ -156,4 +156,72 @@ TEST_CASE("gauss: 8x8 LU factorization without interchanges", "[gauss]")
     // std::cerr << "U\n"  << la::round(U)     << std::endl;
     // std::cerr << "LU\n" << la::round(L * U) << std::endl;
     REQUIRE(approxEqual(A, L * U));
-}
\ No newline at end of file
+}
+TEST_CASE("gauss: compact LU factorization and solve", "[gauss]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            { 3, -7, -2,  2},
+            {-3,  5,  1,  0},
+            { 6, -4,  0, -5},
+            {-9,  5, -5, 12}
+        });
+    la::Matrix LU(A);
+    std::vector<int> piv;
+    REQUIRE(la::luFactor(LU, piv));
+    la::Vector x{1, -2, 3, -4};
+    la::Vector b = A * x;
+    la::luSolve(LU, piv, b);
+    REQUIRE(la::approxEqual(b, x, 1e-4));
+
+    la::Matrix S = la::Matrix::fromRows(
+        {
+            {1, 2},
+            {2, 4}
+        });
+    REQUIRE_FALSE(la::luFactor(S, piv));
+}
+
+TEST_CASE("gauss: row permutations are applied lazily", "[gauss]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {1, 2, 3},
+            {4, 5, 6},
+            {7, 8, 9},
+            {10, 11, 12}
+        });
+    la::Matrix B = A;
+    la::RowPermutation P(4);
+    REQUIRE(P.size() == 4);
+    P.swap(0, 2);
+    P.swap(2, 3);
+    P.swap(1, 1);
+    REQUIRE(P[0] == 2);
+    REQUIRE(P[2] == 3);
+    REQUIRE(P[3] == 0);
+
+    // A is untouched until the permutation is applied, which moves the
+    // rows just as the swaps would have.
+    REQUIRE(A == B);
+    la::permuteRows(A, P);
+    la::swapRows(B, 0, 2);
+    la::swapRows(B, 2, 3);
+    REQUIRE(A == B);
+    REQUIRE(A.row(3)[0] == 1);
+}
+
+TEST_CASE("gauss: row operations respect the leading dimension", "[gauss]")
+{
+    la::BasicMatrix<double> A(3, 4, la::LeadingDim{8});
+    la::fill(A, 1.0);
+    la::scaleRow(A, 1, 2.0, 1);
+    la::replaceRow(A, 2, 1, -3.0, 2);
+    la::swapRows(A, 0, 2);
+    REQUIRE(A == la::BasicMatrix<double>::fromRows(
+        {
+            {1, 1, -5, -5},
+            {1, 2, 2, 2},
+            {1, 1, 1, 1}
+        }));
+}
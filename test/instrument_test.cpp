@@ -0,0 +1,86 @@
+#include "inc/catch.h"
+#include "inc/gauss.h"
+#include "inc/instrument.h"
+#include "inc/matrix.h"
+#include <string>
+#include <vector>
+
+#ifndef LA_INSTRUMENT
+
+TEST_CASE("instrument: compiled out by default", "[instrument]")
+{
+    la::Matrix A = la::Matrix::random(4, 4);
+    la::Matrix B = A * A;
+    REQUIRE_FALSE(la::instrument::enabled());
+    REQUIRE(la::instrument::snapshot().empty());
+}
+
+#else
+
+namespace
+{
+
+// Returns the stats recorded for name, or all zeros if there are none.
+la::instrument::OpStats find(const std::string& name)
+{
+    for (const la::instrument::OpStats& s : la::instrument::snapshot())
+    {
+        if (s.name == name)
+        {
+            return s;
+        }
+    }
+    return {name, 0, 0, 0, 0, 0.0};
+}
+
+}  // namespace
+
+TEST_CASE("instrument: counts calls, work and allocations", "[instrument]")
+{
+    la::Matrix A = la::Matrix::random(4, 3);
+    la::Matrix B = la::Matrix::random(3, 5);
+    REQUIRE(la::instrument::enabled());
+    la::instrument::reset();
+
+    la::Matrix C = A * B;
+    la::Matrix D = A * B;
+    la::instrument::OpStats gemm = find("gemm");
+    REQUIRE(gemm.calls == 2);
+    REQUIRE(gemm.flops == 2 * 2 * 4 * 5 * 3);
+    REQUIRE(gemm.bytes == 2 * (12 + 15 + 40) * sizeof(float));
+    REQUIRE(gemm.allocations == 0);
+
+    // The product's flops include those of the gemm it calls.
+    la::instrument::OpStats mul = find("operator*(Matrix, Matrix)");
+    REQUIRE(mul.calls == 2);
+    REQUIRE(mul.flops == gemm.flops);
+    REQUIRE(mul.allocations >= 2);
+    REQUIRE(mul.seconds >= gemm.seconds);
+
+    la::instrument::reset();
+    REQUIRE(find("gemm").calls == 0);
+}
+
+TEST_CASE("instrument: row operations count toward their caller",
+          "[instrument]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {2, 1, 1},
+            {4, 3, 3},
+            {8, 7, 9}
+        });
+    la::instrument::reset();
+    la::eliminate(A, la::partialPivotSelector);
+
+    la::instrument::OpStats elim = find("eliminate");
+    la::instrument::OpStats fwd = find("forwardReduce");
+    la::instrument::OpStats bwd = find("backwardReduce");
+    REQUIRE(elim.calls == 1);
+    REQUIRE(fwd.flops > 0);
+    REQUIRE(bwd.flops > 0);
+    REQUIRE(elim.flops == fwd.flops + bwd.flops);
+    REQUIRE(elim.bytes == fwd.bytes + bwd.bytes);
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include "inc/catch.h"
+#include "inc/krylov.h"
+#include "inc/precond.h"
+#include <vector>
+
+namespace
+{
+
+// 2D five-point Laplacian on a k x k grid.
+la::SparseMatrix laplacian(int k)
+{
+    std::vector<int> rows, cols;
+    std::vector<float> vals;
+    for (int y = 0; y < k; ++y)
+    {
+        for (int x = 0; x < k; ++x)
+        {
+            int i = y * k + x;
+            int nbrs[] = {x > 0 ? i - 1 : -1, x < k - 1 ? i + 1 : -1,
+                          y > 0 ? i - k : -1, y < k - 1 ? i + k : -1};
+            rows.push_back(i);
+            cols.push_back(i);
+            vals.push_back(4 + 0.1F * x);
+            for (int j : nbrs)
+            {
+                if (j >= 0)
+                {
+                    rows.push_back(i);
+                    cols.push_back(j);
+                    vals.push_back(-1);
+                }
+            }
+        }
+    }
+    return la::SparseMatrix::fromTriplets(k * k, k * k, rows, cols, vals);
+}
+
+}  // namespace
+
+TEST_CASE("krylov: conjugate gradient on dense SPD system", "[krylov]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            { 4, -1,  0},
+            {-1,  4, -1},
+            { 0, -1,  4}
+        });
+    la::Vector b{1, 2, 3};
+    la::Vector x(3, 0.0F);
+    la::ConjugateGradient cg(3);
+    REQUIRE(cg.solve(la::DenseOperator(A), b, x));
+    REQUIRE(cg.iterations() <= 3);
+    REQUIRE(la::approxEqual(A * x, b));
+}
+
+TEST_CASE("krylov: preconditioned conjugate gradient", "[krylov]")
+{
+    la::SparseMatrix A = laplacian(12);
+    int n = A.rows();
+    la::Vector xTrue = la::Vector::random(n, -1, 1);
+    la::Vector b = A * xTrue;
+
+    la::ConjugateGradient cg(n, 1e-6F);
+    la::Vector x(n, 0.0F);
+    REQUIRE(cg.solve(la::SparseOperator(A), b, x));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+    int plainIters = cg.iterations();
+
+    la::Vector invDiag(n);
+    for (int i = 0; i < n; ++i)
+    {
+        invDiag[i] = 1.0F / A.at(i, i);
+    }
+    la::CallbackOperator jacobi(n, n,
+        [&invDiag](const la::Vector& r, la::Vector& z)
+        {
+            for (int i = 0; i < r.size(); ++i)
+            {
+                z[i] = invDiag[i] * r[i];
+            }
+        });
+    x = la::Vector(n, 0.0F);
+    REQUIRE(cg.solve(la::SparseOperator(A), b, x, &jacobi));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+    REQUIRE(cg.iterations() <= plainIters);
+    REQUIRE(cg.residual() <= 1e-6F);
+}
+
+TEST_CASE("krylov: conjugate gradient rejects indefinite matrix", "[krylov]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {1,  0},
+            {0, -1}
+        });
+    la::Vector x(2, 0.0F);
+    la::ConjugateGradient cg(2);
+    REQUIRE_FALSE(cg.solve(la::DenseOperator(A), la::Vector{1, 1}, x));
+}
+
+namespace
+{
+
+// Upwinded convection-diffusion operator on a k x k grid; nonsymmetric.
+la::SparseMatrix convectionDiffusion(int k, float peclet)
+{
+    std::vector<int> rows, cols;
+    std::vector<float> vals;
+    auto add = [&](int i, int j, float v)
+    {
+        rows.push_back(i);
+        cols.push_back(j);
+        vals.push_back(v);
+    };
+    for (int y = 0; y < k; ++y)
+    {
+        for (int x = 0; x < k; ++x)
+        {
+            int i = y * k + x;
+            add(i, i, 4 + peclet);
+            if (x > 0)     add(i, i - 1, -1 - peclet);
+            if (x < k - 1) add(i, i + 1, -1);
+            if (y > 0)     add(i, i - k, -1);
+            if (y < k - 1) add(i, i + k, -1);
+        }
+    }
+    return la::SparseMatrix::fromTriplets(k * k, k * k, rows, cols, vals);
+}
+
+}  // namespace
+
+TEST_CASE("krylov: gmres with and without ILU(0)", "[krylov]")
+{
+    la::SparseMatrix A = convectionDiffusion(12, 5.0F);
+    int n = A.rows();
+    la::SparseOperator op(A);
+    la::Vector xTrue = la::Vector::random(n, -1, 1);
+    la::Vector b = A * xTrue;
+
+    la::GMRES gmres(n, 20, 1e-6F);
+    la::Vector x(n, 0.0F);
+    REQUIRE(gmres.solve(op, b, x));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+    int plainIters = gmres.iterations();
+
+    la::ILU0Preconditioner ilu(A);
+    REQUIRE(ilu.valid());
+    x = la::Vector(n, 0.0F);
+    REQUIRE(gmres.solve(op, b, x, &ilu));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+    REQUIRE(gmres.iterations() < plainIters);
+}
+
+TEST_CASE("krylov: gmres solves dense nonsymmetric system exactly", "[krylov]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {0, 1, 2},
+            {1, 0, 3},
+            {4, -3, 8}
+        });
+    la::Vector b{1, 2, 3};
+    la::Vector x(3, 0.0F);
+    la::GMRES gmres(3, 3);
+    REQUIRE(gmres.solve(la::DenseOperator(A), b, x));
+    REQUIRE(gmres.iterations() <= 3);
+    REQUIRE(la::approxEqual(A * x, b, 1e-4));
+}
+
+TEST_CASE("krylov: bicgstab with Jacobi and ILU(0)", "[krylov]")
+{
+    la::SparseMatrix A = convectionDiffusion(12, 5.0F);
+    int n = A.rows();
+    la::SparseOperator op(A);
+    la::Vector xTrue = la::Vector::random(n, -1, 1);
+    la::Vector b = A * xTrue;
+
+    la::BiCGSTAB bicg(n, 1e-6F);
+    la::Vector x(n, 0.0F);
+    REQUIRE(bicg.solve(op, b, x));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+
+    la::JacobiPreconditioner jacobi(A);
+    x = la::Vector(n, 0.0F);
+    REQUIRE(bicg.solve(op, b, x, &jacobi));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+
+    la::ILU0Preconditioner ilu(A);
+    x = la::Vector(n, 0.0F);
+    REQUIRE(bicg.solve(op, b, x, &ilu));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+}
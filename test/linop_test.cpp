@@ -0,0 +1,31 @@
+#include "inc/catch.h"
+#include "inc/linop.h"
+
+TEST_CASE("linop: dense, sparse and callback operators agree", "[linop]")
+{
+    la::Matrix D = la::Matrix::fromRows(
+        {
+            {2, 0, 1},
+            {0, 3, 0},
+            {1, 0, 4},
+            {0, 5, 0}
+        });
+    la::SparseMatrix S = la::SparseMatrix::fromDense(D);
+    la::DenseOperator dense(D);
+    la::SparseOperator sparse(S);
+    la::CallbackOperator callback(4, 3, [&D](const la::Vector& x, la::Vector& y)
+    {
+        y = D * x;
+    });
+
+    la::Vector x{1, -2, 3};
+    la::Vector y(4, 7.0F);
+    const la::LinearOperator* ops[] = {&dense, &sparse, &callback};
+    for (const la::LinearOperator* op : ops)
+    {
+        REQUIRE(op->rows() == 4);
+        REQUIRE(op->cols() == 3);
+        op->apply(x, y);
+        REQUIRE(y == D * x);
+    }
+}
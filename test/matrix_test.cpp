@@ -1,5 +1,7 @@
 #include "inc/catch.h"
 #include "inc/matrix.h"
+#include "inc/alloc.h"
+#include <cstdint>
 
 TEST_CASE("matrix: construction and equality", "[matrix]")
 {
@@ -53,6 +55,30 @@ TEST_CASE("matrix: iteration", "[matrix]")
     }
 }
 
+TEST_CASE("matrix: aligned and padded storage", "[matrix]")
+{
+    // Short columns are packed; long ones start on cache lines, and a
+    // power-of-two column length gets an extra line of padding.
+    REQUIRE(la::Matrix(3, 5).ld() == 3);
+    REQUIRE(la::Matrix(130, 2).ld() == 144);
+    REQUIRE(la::Matrix(1024, 2).ld() == 1040);
+    REQUIRE(la::BasicMatrix<double>(512, 2).ld() == 520);
+
+    la::Matrix A(1024, 3, 1.0F);
+    for (int j = 0; j < A.cols(); ++j)
+    {
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(&A[j][0]);
+        REQUIRE(addr % la::ALIGNMENT == 0);
+    }
+    REQUIRE(A * la::Vector(3, 1.0F) == la::Vector(1024, 3.0F));
+
+    la::Matrix B(4, 4, la::LeadingDim{16});
+    REQUIRE(B.ld() == 16);
+    B = la::Matrix::identity(4);
+    REQUIRE(la::transpose(B) == la::Matrix::identity(4));
+    REQUIRE(la::Matrix(B) == B);
+}
+
 TEST_CASE("matrix: identity", "[matrix]")
 {
     int n = 4;
@@ -258,6 +284,54 @@ TEST_CASE("matrix: transpose", "[matrix]")
     REQUIRE(la::transpose(A * C) == la::transpose(C) * la::transpose(A));
 }
 
+TEST_CASE("matrix: blocked transpose", "[matrix]")
+{
+    // Sizes straddle the 8 x 8 block boundary in both dimensions.
+    la::Matrix A = la::Matrix::random(37, 21);
+    la::Matrix AT = la::transpose(A);
+    la::Matrix AT4(21, 37);
+    la::transpose(A, AT4, 4);
+    la::BasicMatrix<double> D = la::BasicMatrix<double>::random(19, 30);
+    la::BasicMatrix<double> DT = la::transpose(D);
+    bool equal = true;
+    for (int i = 0; i < A.rows(); ++i)
+    {
+        for (int j = 0; j < A.cols(); ++j)
+        {
+            equal = equal && AT(j, i) == A(i, j) && AT4(j, i) == A(i, j);
+        }
+    }
+    for (int i = 0; i < D.rows(); ++i)
+    {
+        for (int j = 0; j < D.cols(); ++j)
+        {
+            equal = equal && DT(j, i) == D(i, j);
+        }
+    }
+    REQUIRE(equal);
+
+    // Blocks of A transpose into blocks of its transpose.
+    la::Matrix BT(5, 16);
+    la::transpose(A.block(3, 2, 16, 5), BT);
+    REQUIRE(BT == la::Matrix(AT.block(2, 3, 5, 16)));
+}
+
+TEST_CASE("matrix: in-place transpose", "[matrix]")
+{
+    la::Matrix A = la::Matrix::random(29, 29);
+    la::Matrix AT = la::transpose(A);
+    la::transposeInPlace(A);
+    REQUIRE(A == AT);
+
+    la::Matrix B = la::Matrix::random(12, 12);
+    la::Matrix B0 = B;
+    la::transposeInPlace(B.block(2, 2, 9, 9));
+    REQUIRE(B(3, 4) == B0(4, 3));
+    REQUIRE(B(0, 1) == B0(0, 1));
+    la::transposeInPlace(B.block(2, 2, 9, 9));
+    REQUIRE(B == B0);
+}
+
 TEST_CASE("matrix: 2x2 inverse", "[matrix]")
 {
     la::Matrix A = la::Matrix::fromRows(
@@ -338,4 +412,26 @@ TEST_CASE("matrix: 5x5 inverse", "[matrix]")
 TEST_CASE("matrix: determinant", "[matrix]")
 {
     // TODO
-}
\ No newline at end of file
+}
+TEST_CASE("matrix: double and complex inverse", "[matrix]")
+{
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::fromRows(
+        {
+            {0,  1, 2},
+            {1,  0, 3},
+            {4, -3, 8}
+        });
+    la::BasicMatrix<double> AInv(3, 3);
+    REQUIRE(la::inverse(A, AInv));
+    REQUIRE(la::approxEqual(A * AInv, la::BasicMatrix<double>::identity(3)));
+
+    using Complex = std::complex<float>;
+    la::BasicMatrix<Complex> B = la::BasicMatrix<Complex>::fromRows(
+        {
+            {{1, 1}, {0, 2}},
+            {{3, 0}, {1, -1}}
+        });
+    la::BasicMatrix<Complex> BInv(2, 2);
+    REQUIRE(la::inverse(B, BInv));
+    REQUIRE(la::approxEqual(BInv * B, la::BasicMatrix<Complex>::identity(2)));
+}
@@ -0,0 +1,158 @@
+#include "inc/catch.h"
+#include "inc/matrix.h"
+#include "inc/mmio.h"
+#include "inc/sparse.h"
+#include <complex>
+#include <cstdio>  // remove()
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const char* PATH = "mmio_test.mtx";
+
+void writeFile(const std::string& text)
+{
+    std::ofstream(PATH, std::ios::binary) << text;
+}
+
+}  // namespace
+
+TEST_CASE("mmio: dense round trip", "[mmio]")
+{
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::random(7, 5);
+    A(3, 2) = 1.0 / 3;
+    REQUIRE(la::writeMatrixMarket(PATH, A));
+
+    la::MatrixMarketHeader h;
+    REQUIRE(la::readMatrixMarketHeader(PATH, h));
+    REQUIRE_FALSE(h.coordinate);
+    REQUIRE(h.field == la::MatrixMarketField::Real);
+    REQUIRE(h.symmetry == la::MatrixMarketSymmetry::General);
+    REQUIRE(h.rows == 7);
+    REQUIRE(h.cols == 5);
+    REQUIRE(h.entries == 35);
+
+    la::BasicMatrix<double> B(7, 5);
+    REQUIRE(la::readMatrixMarket(PATH, B));
+    REQUIRE(B == A);
+
+    la::BasicMatrix<std::complex<float>> C(2, 2);
+    C(0, 0) = {1, -2};
+    C(1, 0) = {0.5F, 0};
+    C(0, 1) = {0, 3};
+    C(1, 1) = {-1, 1};
+    REQUIRE(la::writeMatrixMarket(PATH, C));
+    la::BasicMatrix<std::complex<float>> D(2, 2);
+    REQUIRE(la::readMatrixMarket(PATH, D));
+    REQUIRE(D == C);
+
+    // Complex entries do not fit a real matrix.
+    la::Matrix E(2, 2);
+    REQUIRE_FALSE(la::readMatrixMarket(PATH, E));
+    std::remove(PATH);
+}
+
+TEST_CASE("mmio: symmetric coordinate files", "[mmio]")
+{
+    writeFile("%%MatrixMarket matrix coordinate real symmetric\n"
+              "% a comment\n"
+              "%\n"
+              "3 3 4\n"
+              "1 1 4.0\n"
+              "2 1 -1\n"
+              "\n"
+              "3 2 +2.5e-1\r\n"
+              "3 3 2");
+    la::Matrix A(3, 3);
+    REQUIRE(la::readMatrixMarket(PATH, A, 2));
+    REQUIRE(A == la::Matrix::fromRows(
+        {
+            { 4, -1,     0},
+            {-1,  0, 0.25F},
+            { 0, 0.25F,  2}
+        }));
+
+    la::SparseMatrix S(1, 1);
+    REQUIRE(la::readMatrixMarket(PATH, S));
+    REQUIRE(S.nonzeros() == 6);
+    REQUIRE(la::toDense(S) == A);
+
+    // Sparse files round trip through the coordinate format.
+    REQUIRE(la::writeMatrixMarket(PATH, S));
+    la::SparseMatrix T(1, 1);
+    REQUIRE(la::readMatrixMarket(PATH, T));
+    REQUIRE(la::toDense(T) == A);
+    std::remove(PATH);
+}
+
+TEST_CASE("mmio: pattern and skew-symmetric files", "[mmio]")
+{
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 3 2\n"
+              "1 3\n"
+              "2 1\n");
+    la::Matrix P(2, 3);
+    REQUIRE(la::readMatrixMarket(PATH, P));
+    REQUIRE(P == la::Matrix::fromRows({{0, 0, 1}, {1, 0, 0}}));
+
+    writeFile("%%MatrixMarket matrix array real skew-symmetric\n"
+              "3 3\n"
+              "1\n"
+              "2\n"
+              "3\n");
+    la::Matrix K(3, 3);
+    REQUIRE(la::readMatrixMarket(PATH, K));
+    REQUIRE(K == la::Matrix::fromRows(
+        {
+            {0, -1, -2},
+            {1,  0, -3},
+            {2,  3,  0}
+        }));
+    std::remove(PATH);
+}
+
+TEST_CASE("mmio: parallel parsing matches serial", "[mmio]")
+{
+    // Large enough to be split into several chunks.
+    int n = 300;
+    la::Matrix A = la::Matrix::random(n, n);
+    REQUIRE(la::writeMatrixMarket(PATH, A));
+    la::Matrix B(n, n), C(n, n);
+    REQUIRE(la::readMatrixMarket(PATH, B, 1));
+    REQUIRE(la::readMatrixMarket(PATH, C, 4));
+    REQUIRE(B == A);
+    REQUIRE(C == A);
+
+    la::SparseMatrix S = la::SparseMatrix::fromDense(A, 0.5F);
+    REQUIRE(la::writeMatrixMarket(PATH, S));
+    la::SparseMatrix T(1, 1);
+    REQUIRE(la::readMatrixMarket(PATH, T, 3));
+    REQUIRE(T.colPtr() == S.colPtr());
+    REQUIRE(T.rowIdx() == S.rowIdx());
+    REQUIRE(T.values() == S.values());
+    std::remove(PATH);
+}
+
+TEST_CASE("mmio: malformed files are rejected", "[mmio]")
+{
+    la::Matrix A(2, 2);
+    const std::vector<std::string> bad{
+        "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 1 x\n",
+        "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n",
+        "%%MatrixMarket matrix array pattern general\n2 2\n",
+        "%%MatrixMarket matrix array real general\n3 2\n1\n2\n3\n4\n5\n6\n",
+        "MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n",
+    };
+    for (const std::string& text : bad)
+    {
+        writeFile(text);
+        REQUIRE_FALSE(la::readMatrixMarket(PATH, A));
+    }
+    std::remove(PATH);
+    REQUIRE_FALSE(la::readMatrixMarket(PATH, A));
+}
@@ -0,0 +1,185 @@
+#include "inc/catch.h"
+#include "inc/binary.h"
+#include "inc/matrix.h"
+#include "inc/npy.h"
+#include <complex>
+#include <cstdio>  // remove()
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const char* PATH = "npy_test.npy";
+const char* ARCHIVE = "npy_test.npz";
+
+// Writes a version 1.0 .npy file with the given header dictionary.
+template <typename S>
+void writeFile(const std::string& dict, const std::vector<S>& entries)
+{
+    std::string header = dict;
+    header.append(63 - (10 + header.size()) % 64, ' ');
+    header += '\n';
+    std::ofstream out(PATH, std::ios::binary);
+    out.write("\x93NUMPY\x01\x00", 8);
+    out.put(static_cast<char>(header.size()));
+    out.put(0);
+    out << header;
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              entries.size() * sizeof(S));
+}
+
+std::string readBytes(const char* path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeBytes(const char* path, const std::string& bytes)
+{
+    std::ofstream(path, std::ios::binary) << bytes;
+}
+
+}  // namespace
+
+TEST_CASE("npy: column-major round trip", "[npy]")
+{
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::random(7, 5);
+    REQUIRE(la::writeNpy(PATH, A));
+
+    la::NpyHeader h;
+    REQUIRE(la::readNpyHeader(PATH, h));
+    REQUIRE(h.dtype == la::BinaryType::Float64);
+    REQUIRE(h.fortranOrder);
+    REQUIRE(h.rows == 7);
+    REQUIRE(h.cols == 5);
+    REQUIRE(h.dataOffset % 64 == 0);
+
+    la::BasicMatrix<double> B(7, 5);
+    REQUIRE(la::readNpy(PATH, B));
+    REQUIRE(B == A);
+
+    // Column-major files are used in place.
+    la::BasicMappedMatrix<double> M;
+    REQUIRE(M.open(PATH));
+    REQUIRE(M.rows() == 7);
+    REQUIRE(M.cols() == 5);
+    REQUIRE(la::BasicMatrix<double>(M) == A);
+
+    // The shape must match.
+    la::BasicMatrix<double> C(5, 7);
+    REQUIRE_FALSE(la::readNpy(PATH, C));
+    la::MappedMatrix F;
+    REQUIRE_FALSE(F.open(PATH));
+    std::remove(PATH);
+}
+
+TEST_CASE("npy: row-major files are transposed", "[npy]")
+{
+    writeFile<float>("{'descr': '<f4', 'fortran_order': False, "
+                     "'shape': (2, 3), }",
+                     {1, 2, 3, 4, 5, 6});
+    la::NpyHeader h;
+    REQUIRE(la::readNpyHeader(PATH, h));
+    REQUIRE_FALSE(h.fortranOrder);
+
+    la::Matrix A(2, 3);
+    REQUIRE(la::readNpy(PATH, A));
+    REQUIRE(A == la::Matrix::fromRows({{1, 2, 3}, {4, 5, 6}}));
+
+    // Entries are converted to the type of the matrix.
+    la::BasicMatrix<std::complex<double>> Z(2, 3);
+    REQUIRE(la::readNpy(PATH, Z));
+    REQUIRE(Z(1, 0) == std::complex<double>(4, 0));
+
+    // Row-major files cannot be mapped in place.
+    la::MappedMatrix M;
+    REQUIRE_FALSE(M.open(PATH));
+
+    // One-dimensional arrays are columns.
+    writeFile<float>("{'descr': '<f4', 'fortran_order': False, "
+                     "'shape': (3,), }",
+                     {7, 8, 9});
+    la::Matrix x(3, 1);
+    REQUIRE(la::readNpy(PATH, x));
+    REQUIRE(x == la::Matrix::fromRows({{7}, {8}, {9}}));
+    REQUIRE(M.open(PATH));
+    REQUIRE(M(2, 0) == 9);
+    M.close();
+    std::remove(PATH);
+}
+
+TEST_CASE("npy: complex entries do not fit real matrices", "[npy]")
+{
+    la::BasicMatrix<std::complex<float>> A(2, 2);
+    A(0, 0) = {1, -2};
+    A(1, 0) = {0.5F, 0};
+    A(0, 1) = {0, 3};
+    A(1, 1) = {-1, 1};
+    REQUIRE(la::writeNpy(PATH, A));
+    la::BasicMatrix<std::complex<double>> B(2, 2);
+    REQUIRE(la::readNpy(PATH, B));
+    REQUIRE(B(0, 0) == std::complex<double>(1, -2));
+    REQUIRE(B(1, 1) == std::complex<double>(-1, 1));
+    la::BasicMatrix<double> C(2, 2);
+    REQUIRE_FALSE(la::readNpy(PATH, C));
+    std::remove(PATH);
+}
+
+TEST_CASE("npy: malformed files are rejected", "[npy]")
+{
+    la::Matrix A(2, 2);
+    const std::vector<std::string> bad{
+        "{'descr': '>f4', 'fortran_order': True, 'shape': (2, 2), }",
+        "{'descr': '<i4', 'fortran_order': True, 'shape': (2, 2), }",
+        "{'descr': '<f4', 'shape': (2, 2), }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 2, 1), }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3), }",
+    };
+    for (const std::string& dict : bad)
+    {
+        writeFile<float>(dict, {1, 2, 3, 4});
+        la::NpyHeader h;
+        REQUIRE_FALSE((la::readNpyHeader(PATH, h) && la::readNpy(PATH, A)));
+    }
+    std::remove(PATH);
+    REQUIRE_FALSE(la::readNpy(PATH, A));
+}
+
+TEST_CASE("npy: npz archives round trip", "[npy]")
+{
+    la::Matrix A = la::Matrix::random(4, 3);
+    la::Matrix B = la::Matrix::random(1, 6);
+    REQUIRE(la::writeNpz<float>(ARCHIVE, {"a", "b"}, {A, B}));
+
+    la::NpzReader npz;
+    REQUIRE(npz.open(ARCHIVE));
+    REQUIRE(npz.names() == std::vector<std::string>{"a", "b"});
+    la::NpyHeader h;
+    REQUIRE(npz.header("b", h));
+    REQUIRE(h.rows == 1);
+    REQUIRE(h.cols == 6);
+    REQUIRE_FALSE(npz.header("c", h));
+
+    la::Matrix C(4, 3), D(1, 6);
+    REQUIRE(npz.read("a", C));
+    REQUIRE(npz.read("b", D));
+    REQUIRE(C == A);
+    REQUIRE(D == B);
+    npz.close();
+
+    // A flipped bit in the entries fails the CRC-32 check.
+    std::string bytes = readBytes(ARCHIVE);
+    bytes[30 + 5 + 64 + 4] ^= 1;
+    writeBytes(ARCHIVE, bytes);
+    REQUIRE(npz.open(ARCHIVE));
+    REQUIRE_FALSE(npz.read("a", C));
+    REQUIRE(npz.read("b", D));
+
+    // So does anything that is not a zip archive.
+    writeBytes(ARCHIVE, std::string(100, 'x'));
+    REQUIRE_FALSE(npz.open(ARCHIVE));
+    std::remove(ARCHIVE);
+}
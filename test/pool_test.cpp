@@ -0,0 +1,84 @@
+#include "inc/catch.h"
+#include "inc/matrix.h"
+#include "inc/pool.h"
+#include "inc/vector.h"
+#include <algorithm>  // sort()
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("pool: vectors are columns of one matrix", "[pool]")
+{
+    la::VectorPool pool(3, 4);
+    REQUIRE(pool.size() == 0);
+    REQUIRE(pool.capacity() == 4);
+    REQUIRE(pool.append(la::Vector{1, 2, 3}) == 0);
+    REQUIRE(pool.append(la::Vector{4, 5, 6}) == 1);
+    int i = pool.claim(2);
+    REQUIRE(i == 2);
+    la::fill(pool[2], 7.0F);
+    la::fill(pool[3], 8.0F);
+    REQUIRE(pool.append(la::Vector{0, 0, 0}) == -1);
+    REQUIRE(pool.claim() == -1);
+
+    la::Matrix P(pool.view());
+    REQUIRE(P == la::Matrix::fromRows(
+        {
+            {1, 4, 7, 8},
+            {2, 5, 7, 8},
+            {3, 6, 7, 8}
+        }));
+
+    // The pool feeds gemm without a copy.
+    la::Matrix C(3, 3);
+    la::gemm(la::Op::NoTrans, la::Op::Trans, 1.0F, pool.view(), pool.view(),
+             0.0F, C);
+    REQUIRE(C(0, 2) == 1 * 3 + 4 * 6 + 7 * 7 + 8 * 8);
+
+    pool.clear();
+    REQUIRE(pool.size() == 0);
+    REQUIRE(pool.append(la::Vector{9, 9, 9}) == 0);
+    REQUIRE(pool[0][1] == 9);
+}
+
+TEST_CASE("pool: concurrent appends", "[pool]")
+{
+    int threads = 4;
+    int each = 500;
+    la::BasicVectorPool<double> pool(40, threads * each + 10);
+    std::atomic<int> failures{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        // Catch assertions are not thread-safe, so workers only count.
+        workers.emplace_back([&pool, &failures, t, each]()
+        {
+            la::BasicVector<double> v(40);
+            for (int k = 0; k < each; ++k)
+            {
+                la::fill(v, double(t * each + k));
+                failures += (pool.append(v) < 0);
+            }
+        });
+    }
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+    REQUIRE(failures == 0);
+    REQUIRE(pool.size() == threads * each);
+
+    // Every vector arrives whole and exactly once.
+    std::vector<double> seen;
+    for (int i = 0; i < pool.size(); ++i)
+    {
+        la::BasicVectorView<double> v = pool[i];
+        REQUIRE(v[0] == v[39]);
+        seen.push_back(v[0]);
+    }
+    std::sort(seen.begin(), seen.end());
+    for (int i = 0; i < threads * each; ++i)
+    {
+        REQUIRE(seen[i] == i);
+    }
+}
@@ -0,0 +1,48 @@
+#include "inc/catch.h"
+#include "inc/precond.h"
+
+TEST_CASE("precond: jacobi applies inverse diagonal", "[precond]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {2, 1, 0},
+            {1, 4, 1},
+            {0, 1, 0}
+        });
+    la::JacobiPreconditioner dense(A);
+    la::JacobiPreconditioner sparse(la::SparseMatrix::fromDense(A));
+    la::Vector z(3);
+    dense.apply(la::Vector{2, 2, 2}, z);
+    REQUIRE(z == la::Vector{1, 0.5F, 2});
+    sparse.apply(la::Vector{2, 2, 2}, z);
+    REQUIRE(z == la::Vector{1, 0.5F, 2});
+}
+
+TEST_CASE("precond: ILU(0) of tridiagonal matrix is exact", "[precond]")
+{
+    // A tridiagonal matrix has no fill, so ILU(0) is its LU factorization.
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            { 4, -1,  0,  0},
+            {-2,  4, -1,  0},
+            { 0, -2,  4, -1},
+            { 0,  0, -2,  4}
+        });
+    la::ILU0Preconditioner ilu(la::SparseMatrix::fromDense(A));
+    REQUIRE(ilu.valid());
+    la::Vector b{1, 2, 3, 4};
+    la::Vector z(4);
+    ilu.apply(b, z);
+    REQUIRE(la::approxEqual(A * z, b));
+}
+
+TEST_CASE("precond: ILU(0) detects zero pivot", "[precond]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {0, 1},
+            {1, 0}
+        });
+    la::ILU0Preconditioner ilu(la::SparseMatrix::fromDense(A));
+    REQUIRE_FALSE(ilu.valid());
+}
@@ -0,0 +1,90 @@
+#include "inc/catch.h"
+#include "inc/matrix.h"
+#include "inc/random.h"
+#include <cmath>
+#include <complex>
+
+TEST_CASE("random: Philox known answers", "[random]")
+{
+    // Test vectors of the Random123 reference implementation.
+    REQUIRE(la::Philox(0)({0, 0, 0, 0})
+            == la::Philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                 0x9b00dbd8});
+    REQUIRE(la::Philox(~0ULL)({~0U, ~0U, ~0U, ~0U})
+            == la::Philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                 0x6d5451fd});
+    REQUIRE(la::Philox(0x299f31d0a4093822ULL)(
+                {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344})
+            == la::Philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                 0x24126ea1});
+}
+
+TEST_CASE("random: blocks and threads reproduce the whole", "[random]")
+{
+    la::BasicMatrix<double> A(40, 30), B(40, 30), C(40, 30);
+    la::fillUniform(A, 7, -1.0, 1.0);
+    la::fillUniform(B, 7, -1.0, 1.0, 0, 0, 4);
+    REQUIRE(A == B);
+
+    // Generate C in four blocks, out of order.
+    la::fillUniform(C.block(25, 10, 15, 20), 7, -1.0, 1.0, 25, 10);
+    la::fillUniform(C.block(0, 10, 25, 20), 7, -1.0, 1.0, 0, 10);
+    la::fillUniform(C.block(25, 0, 15, 10), 7, -1.0, 1.0, 25, 0, 3);
+    la::fillUniform(C.block(0, 0, 25, 10), 7, -1.0, 1.0);
+    REQUIRE(C == A);
+
+    la::fillUniform(C, 8, -1.0, 1.0);
+    REQUIRE(C != A);
+    REQUIRE(la::Matrix::random(5, 5) != la::Matrix::random(5, 5));
+}
+
+TEST_CASE("random: uniform entries lie in range", "[random]")
+{
+    la::BasicMatrix<std::complex<float>> Z(50, 20);
+    la::fillUniform(Z, 1, {-2, 3}, {2, 4}, 0, 0, 0);
+    for (int j = 0; j < Z.cols(); ++j)
+    {
+        for (int i = 0; i < Z.rows(); ++i)
+        {
+            REQUIRE(Z(i, j).real() >= -2);
+            REQUIRE(Z(i, j).real() <= 2);
+            REQUIRE(Z(i, j).imag() >= 3);
+            REQUIRE(Z(i, j).imag() <= 4);
+        }
+    }
+}
+
+TEST_CASE("random: normal entries have the given moments", "[random]")
+{
+    int m = 200;
+    int n = 100;
+    la::BasicMatrix<double> A(m, n);
+    la::fillNormal(A, 3, 5.0, 2.0);
+    double sum = 0;
+    double squares = 0;
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            sum += A(i, j);
+            squares += A(i, j) * A(i, j);
+        }
+    }
+    double mean = sum / (m * n);
+    double variance = squares / (m * n) - mean * mean;
+    REQUIRE(std::abs(mean - 5) < 0.05);
+    REQUIRE(std::abs(variance - 4) < 0.2);
+
+    la::BasicMatrix<std::complex<float>> Z(m, n);
+    la::fillNormal(Z, 3, {0, 1}, 1.0F);
+    std::complex<double> total = 0;
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            total += std::complex<double>(Z(i, j));
+        }
+    }
+    REQUIRE(std::abs(total / double(m * n) - std::complex<double>(0, 1))
+            < 0.05);
+}
@@ -0,0 +1,68 @@
+#include "inc/catch.h"
+#include "inc/refine.h"
+#include <cmath>
+
+namespace
+{
+
+la::BasicMatrix<double> hilbert(int n)
+{
+    la::BasicMatrix<double> H(n, n);
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            H[j][i] = 1.0 / (i + j + 1);
+        }
+    }
+    return H;
+}
+
+double maxRelError(const la::BasicVector<double>& x,
+                   const la::BasicVector<double>& y)
+{
+    double err = 0.0;
+    for (int i = 0; i < x.size(); ++i)
+    {
+        err = std::max(err, std::abs(x[i] - y[i]) / std::abs(y[i]));
+    }
+    return err;
+}
+
+}  // namespace
+
+TEST_CASE("refine: reaches double accuracy from single-precision factors",
+          "[refine]")
+{
+    la::BasicMatrix<double> A = hilbert(5);
+    la::BasicVector<double> xTrue{1.0, -2.0, 3.0, -4.0, 5.0};
+    la::BasicVector<double> x(5);
+    la::MixedPrecisionSolver solver(A);
+    REQUIRE(solver.solve(A * xTrue, x));
+    REQUIRE_FALSE(solver.usedFallback());
+    REQUIRE(solver.iterations() > 1);
+    REQUIRE(maxRelError(x, xTrue) < 1e-9);
+}
+
+TEST_CASE("refine: falls back when refinement cannot converge", "[refine]")
+{
+    la::BasicMatrix<double> A = hilbert(9);
+    la::BasicVector<double> xTrue(9, 1.0);
+    la::BasicVector<double> x(9);
+    la::MixedPrecisionSolver solver(A);
+    REQUIRE(solver.solve(A * xTrue, x));
+    REQUIRE(solver.usedFallback());
+    REQUIRE(maxRelError(x, xTrue) < 1e-3);
+}
+
+TEST_CASE("refine: singular matrix", "[refine]")
+{
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::fromRows(
+        {
+            {1, 2},
+            {2, 4}
+        });
+    la::BasicVector<double> x(2);
+    la::MixedPrecisionSolver solver(A);
+    REQUIRE_FALSE(solver.solve({1.0, 1.0}, x));
+}
@@ -0,0 +1,43 @@
+#include "inc/catch.h"
+#include "inc/sparse.h"
+
+TEST_CASE("sparse: triplets with duplicates", "[sparse]")
+{
+    la::SparseMatrix A = la::SparseMatrix::fromTriplets(3, 3,
+        {2, 0, 1, 0, 2},
+        {0, 0, 1, 2, 0},
+        {1, 4, 5, 2, 3});
+    REQUIRE(A.nonzeros() == 4);
+    REQUIRE(A.at(0, 0) == 4);
+    REQUIRE(A.at(2, 0) == 4);
+    REQUIRE(A.at(1, 1) == 5);
+    REQUIRE(A.at(0, 2) == 2);
+    REQUIRE(A.at(1, 2) == 0);
+}
+
+TEST_CASE("sparse: dense round trip", "[sparse]")
+{
+    la::Matrix D = la::Matrix::fromRows(
+        {
+            {1, 0, 0, 2},
+            {0, 0, 3, 0},
+            {4, 5, 0, 6}
+        });
+    la::SparseMatrix S = la::SparseMatrix::fromDense(D);
+    REQUIRE(S.nonzeros() == 6);
+    REQUIRE(la::toDense(S) == D);
+    REQUIRE(la::toDense(la::transpose(S)) == la::transpose(D));
+}
+
+TEST_CASE("sparse: matrix-vector multiplication", "[sparse]")
+{
+    la::Matrix D = la::Matrix::fromRows(
+        {
+            {2, 0, 1},
+            {0, 3, 0},
+            {1, 0, 4}
+        });
+    la::Vector x{1, -2, 3};
+    REQUIRE(la::SparseMatrix::fromDense(D) * x == D * x);
+    REQUIRE(la::SparseMatrix::identity(3) * x == x);
+}
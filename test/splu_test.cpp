@@ -0,0 +1,99 @@
+#include "inc/catch.h"
+#include "inc/splu.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// 2D five-point Laplacian on a k x k grid, plus an asymmetric convection term.
+la::SparseMatrix gridMatrix(int k, float convection)
+{
+    std::vector<int> rows, cols;
+    std::vector<float> vals;
+    auto add = [&](int i, int j, float v)
+    {
+        rows.push_back(i);
+        cols.push_back(j);
+        vals.push_back(v);
+    };
+    for (int y = 0; y < k; ++y)
+    {
+        for (int x = 0; x < k; ++x)
+        {
+            int i = y * k + x;
+            add(i, i, 4);
+            if (x > 0)     add(i, i - 1, -1 - convection);
+            if (x < k - 1) add(i, i + 1, -1 + convection);
+            if (y > 0)     add(i, i - k, -1);
+            if (y < k - 1) add(i, i + k, -1);
+        }
+    }
+    return la::SparseMatrix::fromTriplets(k * k, k * k, rows, cols, vals);
+}
+
+}  // namespace
+
+TEST_CASE("splu: minimum degree ordering is a permutation", "[splu]")
+{
+    la::SparseMatrix A = gridMatrix(6, 0.0F);
+    std::vector<int> q = la::minimumDegreeOrder(A);
+    REQUIRE(q.size() == 36);
+    std::sort(q.begin(), q.end());
+    for (int i = 0; i < 36; ++i)
+    {
+        REQUIRE(q[i] == i);
+    }
+}
+
+TEST_CASE("splu: solve matches dense inverse", "[splu]")
+{
+    la::Matrix D = la::Matrix::fromRows(
+        {
+            {0, 1, 2},
+            {1, 0, 3},
+            {4, -3, 8}
+        });
+    la::SparseMatrix A = la::SparseMatrix::fromDense(D);
+    la::SparseLU lu;
+    lu.analyze(A);
+    REQUIRE(lu.factor(A));
+    la::Vector b{1, 2, 3};
+    la::Vector x(3);
+    REQUIRE(lu.solve(b, x));
+    la::Matrix DInv(3, 3);
+    REQUIRE(la::inverse(D, DInv));
+    REQUIRE(la::approxEqual(x, DInv * b));
+}
+
+TEST_CASE("splu: refactor with same pattern", "[splu]")
+{
+    la::SparseLU lu;
+    la::SparseMatrix A = gridMatrix(10, 0.3F);
+    lu.analyze(A);
+    REQUIRE(lu.factor(A));
+    la::Vector xTrue = la::Vector::random(100, -1, 1);
+    la::Vector x(100);
+    REQUIRE(lu.solve(A * xTrue, x));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+    REQUIRE(lu.nonzerosL() < 100 * 100 / 4);
+
+    la::SparseMatrix B = gridMatrix(10, -0.2F);
+    REQUIRE(lu.factor(B));
+    REQUIRE(lu.solve(B * xTrue, x));
+    REQUIRE(la::approxEqual(x, xTrue, 1e-4));
+}
+
+TEST_CASE("splu: singular matrix", "[splu]")
+{
+    la::SparseMatrix A = la::SparseMatrix::fromDense(la::Matrix::fromRows(
+        {
+            {1, 2},
+            {2, 4}
+        }));
+    la::SparseLU lu;
+    lu.analyze(A);
+    REQUIRE_FALSE(lu.factor(A));
+    la::Vector x(2);
+    REQUIRE_FALSE(lu.solve(la::Vector{1, 1}, x));
+}
@@ -0,0 +1,163 @@
+#include "inc/catch.h"
+#include "inc/gauss.h"
+#include "inc/matrix.h"
+#include "inc/tiled.h"
+#include <complex>
+#include <cstdio>  // remove()
+#include <vector>
+
+namespace
+{
+
+const char* PATH_A = "tiled_test_a.lat";
+const char* PATH_B = "tiled_test_b.lat";
+const char* PATH_C = "tiled_test_c.lat";
+const char* CHECKPOINT = "tiled_test.ckpt";
+
+}  // namespace
+
+TEST_CASE("tiled: tiles are cached and written back", "[tiled]")
+{
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::random(10, 7);
+    {
+        la::BasicTiledMatrix<double> T;
+        REQUIRE_FALSE(T.isOpen());
+        REQUIRE(T.create(PATH_A, 10, 7, 4, 2));
+        REQUIRE(T.tileRows() == 3);
+        REQUIRE(T.tileCols() == 2);
+        REQUIRE(T.write(A));
+        REQUIRE(T.close());
+    }
+
+    la::BasicTiledMatrix<double> T;
+    REQUIRE(T.open(PATH_A, 2));
+    REQUIRE(T.rows() == 10);
+    REQUIRE(T.cols() == 7);
+    REQUIRE(T.tileSize() == 4);
+
+    // Edge tiles are smaller.
+    la::BasicMatrixView<double> V = T.acquire(2, 1);
+    REQUIRE(V.rows() == 2);
+    REQUIRE(V.cols() == 3);
+    REQUIRE(V(1, 2) == A(9, 6));
+    T.release(2, 1);
+
+    // A cached tile is not read again; the least recently used is evicted.
+    T.acquire(0, 0);
+    T.release(0, 0);
+    T.acquire(2, 1);
+    T.release(2, 1);
+    REQUIRE(T.tileReads() == 2);
+    T.acquire(1, 0, true)(0, 0) = 42;
+    T.release(1, 0);
+    T.acquire(0, 0);
+    T.release(0, 0);
+    REQUIRE(T.tileReads() == 4);
+    REQUIRE(T.tileWrites() == 0);
+    T.acquire(0, 1);
+    T.release(0, 1);
+    REQUIRE(T.tileWrites() == 1);
+
+    A(4, 0) = 42;
+    la::BasicMatrix<double> B(10, 7);
+    REQUIRE(T.read(B));
+    REQUIRE(B == A);
+
+    // The type of the entries must match.
+    la::BasicTiledMatrix<float> F;
+    REQUIRE_FALSE(F.open(PATH_A));
+    std::remove(PATH_A);
+}
+
+TEST_CASE("tiled: gemm matches the in-memory product", "[tiled]")
+{
+    la::Matrix A = la::Matrix::random(13, 9);
+    la::Matrix B = la::Matrix::random(9, 6);
+    la::Matrix C = la::Matrix::random(13, 6);
+    la::TiledMatrix TA, TB, TC;
+    REQUIRE(TA.create(PATH_A, 13, 9, 4, 3));
+    REQUIRE(TB.create(PATH_B, 9, 6, 4, 3));
+    REQUIRE(TC.create(PATH_C, 13, 6, 4, 1));
+    REQUIRE(TA.write(A));
+    REQUIRE(TB.write(B));
+    REQUIRE(TC.write(C));
+
+    REQUIRE(la::gemm(2.0F, TA, TB, 0.5F, TC));
+    la::Matrix D(13, 6);
+    REQUIRE(TC.read(D));
+    la::Matrix E = C;
+    la::gemm(la::Op::NoTrans, la::Op::NoTrans, 2.0F, A, B, 0.5F, E);
+    REQUIRE(la::approxEqual(D, E, 1e-4F));
+    std::remove(PATH_A);
+    std::remove(PATH_B);
+    std::remove(PATH_C);
+}
+
+TEST_CASE("tiled: left-looking LU solves systems", "[tiled]")
+{
+    int n = 11;
+    la::BasicMatrix<std::complex<double>> A =
+        la::BasicMatrix<std::complex<double>>::random(n, n);
+    la::BasicVector<std::complex<double>> b =
+        la::BasicVector<std::complex<double>>::random(n);
+
+    la::BasicTiledMatrix<std::complex<double>> T;
+    REQUIRE(T.create(PATH_A, n, n, 3, 2));
+    REQUIRE(T.write(A));
+    std::vector<int> piv;
+    REQUIRE(la::luFactor(T, piv));
+    REQUIRE(static_cast<int>(piv.size()) == n);
+    la::BasicVector<std::complex<double>> x = b;
+    REQUIRE(la::luSolve(T, piv, x));
+
+    la::BasicMatrix<std::complex<double>> LU = A;
+    std::vector<int> p;
+    REQUIRE(la::luFactor(LU, p));
+    la::BasicVector<std::complex<double>> y = b;
+    la::luSolve(LU, p, y);
+    REQUIRE(la::approxEqual(x, y, 1e-9));
+
+    // Singular matrices are detected.
+    REQUIRE(T.write(la::BasicMatrix<std::complex<double>>(n, n)));
+    REQUIRE_FALSE(la::luFactor(T, piv));
+    std::remove(PATH_A);
+}
+
+TEST_CASE("tiled: interrupted factorizations resume", "[tiled]")
+{
+    int n = 10;
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::random(n, n);
+    la::BasicVector<double> b = la::BasicVector<double>::random(n);
+    std::remove(CHECKPOINT);
+
+    la::BasicTiledMatrix<double> T;
+    REQUIRE(T.create(PATH_A, n, n, 4, 2));
+    REQUIRE(T.write(A));
+    std::vector<int> piv;
+    REQUIRE_FALSE(la::luFactor(T, piv, CHECKPOINT, 2));
+    REQUIRE(piv.size() == 8);
+    REQUIRE(T.close());
+
+    // A fresh process picks up after the last completed panel.
+    std::vector<int> resumed;
+    REQUIRE(T.open(PATH_A, 2));
+    REQUIRE(la::luFactor(T, resumed, CHECKPOINT));
+    REQUIRE(static_cast<int>(resumed.size()) == n);
+    REQUIRE(T.tileReads() < 3 * 3 * 3);
+    REQUIRE(std::equal(piv.begin(), piv.end(), resumed.begin()));
+    la::BasicVector<double> x = b;
+    REQUIRE(la::luSolve(T, resumed, x));
+
+    la::BasicTiledMatrix<double> U;
+    REQUIRE(U.create(PATH_B, n, n, 4, 2));
+    REQUIRE(U.write(A));
+    std::vector<int> whole;
+    REQUIRE(la::luFactor(U, whole));
+    REQUIRE(whole == resumed);
+    la::BasicVector<double> y = b;
+    REQUIRE(la::luSolve(U, whole, y));
+    REQUIRE(x == y);
+    std::remove(PATH_A);
+    std::remove(PATH_B);
+    std::remove(CHECKPOINT);
+}
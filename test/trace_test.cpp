@@ -0,0 +1,87 @@
+#include "inc/catch.h"
+#include "inc/gauss.h"
+#include "inc/trace.h"
+#include <cstdio>  // remove()
+#include <vector>
+
+using la::trace::Event;
+using la::trace::EventType;
+
+TEST_CASE("trace: records pivots and row operations", "[trace]")
+{
+    la::Matrix A = la::Matrix::fromRows(
+        {
+            {2, 1},
+            {4, 3}
+        });
+    la::trace::start();
+    la::eliminate(A, la::partialPivotSelector);
+    la::trace::stop();
+    la::swapRows(A, 0, 1);  // not recorded
+
+    std::vector<Event> events = la::trace::events();
+    REQUIRE(events.size() == 7);
+    REQUIRE(la::trace::dropped() == 0);
+    for (int i = 0; i < 7; ++i)
+    {
+        REQUIRE(events[i].seq == i + 1);
+    }
+    REQUIRE(events[0].type == EventType::Pivot);
+    REQUIRE(events[0].row1 == 1);
+    REQUIRE(events[0].col == 0);
+    REQUIRE(events[0].re == 4.0);
+    REQUIRE(events[1].type == EventType::Replace);
+    REQUIRE(events[1].row1 == 0);
+    REQUIRE(events[1].row2 == 1);
+    REQUIRE(events[1].re == -0.5);
+    REQUIRE(events[2].type == EventType::Pivot);
+    REQUIRE(events[2].row1 == 0);
+    REQUIRE(events[2].col == 1);
+    REQUIRE(events[3].type == EventType::Swap);
+    REQUIRE(events[6].type == EventType::Scale);
+    REQUIRE(events[6].row1 == 0);
+    REQUIRE(events[6].re == 0.25);
+}
+
+TEST_CASE("trace: ring keeps the newest events", "[trace]")
+{
+    la::Matrix A(4, 4, 1.0F);
+    la::trace::start(3);  // rounded up to 4
+    for (int i = 0; i < 10; ++i)
+    {
+        la::swapRows(A, i % 4, (i + 1) % 4);
+    }
+    la::trace::stop();
+
+    std::vector<Event> events = la::trace::events();
+    REQUIRE(events.size() == 4);
+    REQUIRE(la::trace::dropped() == 6);
+    REQUIRE(events.front().seq == 7);
+    REQUIRE(events.back().seq == 10);
+    REQUIRE(events.back().row1 == 1);
+    REQUIRE(events.back().row2 == 2);
+}
+
+TEST_CASE("trace: files round trip", "[trace]")
+{
+    la::BasicMatrix<std::complex<double>> A(2, 2, {1.0, 2.0});
+    la::trace::start();
+    la::scaleRow(A, 1, {0.0, -1.0});
+    la::trace::stop();
+
+    const char* path = "trace_test.latrace";
+    REQUIRE(la::trace::save(path));
+    std::vector<Event> events;
+    std::uint64_t dropped = 1;
+    REQUIRE(la::trace::load(path, events, dropped));
+    std::remove(path);
+    REQUIRE(dropped == 0);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == EventType::Scale);
+    REQUIRE(events[0].row1 == 1);
+    REQUIRE(events[0].row2 == -1);
+    REQUIRE(events[0].re == 0.0);
+    REQUIRE(events[0].im == -1.0);
+
+    REQUIRE_FALSE(la::trace::load("no_such_file.latrace", events, dropped));
+}
@@ -0,0 +1,83 @@
+#include "inc/catch.h"
+#include "inc/transform.h"
+#include <vector>
+
+namespace
+{
+
+struct Cloud
+{
+    explicit Cloud(int n)
+    : x(n), y(n), z(n)
+    {}
+
+    la::PointsSoA soa()
+    {
+        return {x.data(), y.data(), z.data(), static_cast<int>(x.size())};
+    }
+
+    la::FixedVector<3> point(int i) const
+    {
+        return {x[i], y[i], z[i]};
+    }
+
+    std::vector<float> x, y, z;
+};
+
+Cloud randomCloud(int n)
+{
+    Cloud c(n);
+    la::Vector r = la::Vector::random(3 * n, -10, 10);
+    for (int i = 0; i < n; ++i)
+    {
+        c.x[i] = r[3 * i];
+        c.y[i] = r[3 * i + 1];
+        c.z[i] = r[3 * i + 2];
+    }
+    return c;
+}
+
+}  // namespace
+
+TEST_CASE("transform: projective transform of point cloud", "[transform]")
+{
+    la::FixedMatrix<4, 4> M = la::FixedMatrix<4, 4>::fromRows(
+        {
+            {1.0F,  0.2F, 0.0F,  3.0F},
+            {0.1F,  0.9F, 0.3F, -1.0F},
+            {0.0F, -0.4F, 1.1F,  2.0F},
+            {0.01F, 0.0F, 0.02F, 1.0F}
+        });
+    int n = 1003;
+    Cloud in = randomCloud(n);
+    for (int threads : {1, 3})
+    {
+        Cloud out(n);
+        la::transformPoints(M, in.soa(), out.soa(), threads);
+        for (int i = 0; i < n; ++i)
+        {
+            la::FixedVector<3> expected =
+                la::dehomogenize(M * la::homogenize(in.point(i)));
+            REQUIRE(la::approxEqual(out.point(i), expected));
+        }
+    }
+}
+
+TEST_CASE("transform: affine transform in place", "[transform]")
+{
+    la::FixedMatrix<3, 4> M = la::FixedMatrix<3, 4>::fromRows(
+        {
+            {0, -1, 0,  5},
+            {1,  0, 0, -5},
+            {0,  0, 2,  0}
+        });
+    int n = 37;
+    Cloud c = randomCloud(n);
+    Cloud original = c;
+    la::transformPoints(M, c.soa(), c.soa(), 4);
+    for (int i = 0; i < n; ++i)
+    {
+        REQUIRE(la::approxEqual(c.point(i),
+                                M * la::homogenize(original.point(i))));
+    }
+}
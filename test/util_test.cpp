@@ -25,4 +25,28 @@ TEST_CASE("util: approxEqual", "[util]")
         // std::cerr << f << " " << la::approxEqual(f, 0) << std::endl;
         REQUIRE(la::approxEqual(f, 0) == b);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("util: approxEqual for double and complex", "[util]")
+{
+    REQUIRE(la::approxEqual(1.0, 1.0 + 1e-13));
+    REQUIRE_FALSE(la::approxEqual(1.0, 1.0 + 1e-9));
+    REQUIRE(la::approxEqual(std::complex<float>(1, 2),
+                            std::complex<float>(1, 2.000001F)));
+    REQUIRE_FALSE(la::approxEqual(std::complex<double>(1, 2),
+                                  std::complex<double>(1, 2.001)));
+}
+
+TEST_CASE("util: ulpDistance", "[util]")
+{
+    REQUIRE(la::ulpDistance(1.0F, 1.0F) == 0);
+    REQUIRE(la::ulpDistance(0.0F, -0.0F) == 0);
+    REQUIRE(la::ulpDistance(1.0F, std::nextafter(1.0F, 2.0F)) == 1);
+    float tiny = std::numeric_limits<float>::denorm_min();
+    REQUIRE(la::ulpDistance(-tiny, tiny) == 2);
+    REQUIRE(la::ulpDistance(-1.0, 1.0) == 2 * la::ulpDistance(0.0, 1.0));
+    REQUIRE(la::ulpDistance(1.0, std::nan(""))
+            == std::numeric_limits<std::uint64_t>::max());
+    REQUIRE(la::ulpDistance(std::complex<double>(1, 1),
+                            std::complex<double>(1, std::nextafter(1.0, 0.0)))
+            == 1);
+}
@@ -1,5 +1,6 @@
 #include "inc/catch.h"
 #include "inc/vector.h"
+#include "inc/alloc.h"
 
 TEST_CASE("vector: construction and access", "[vector]")
 {
@@ -57,4 +58,38 @@ TEST_CASE("vector: homogeneous coordinates", "[vector]")
     REQUIRE(la::dehomogenize(la::Vector{10, -6, 14, 2}) == v);
     REQUIRE(la::dehomogenize(la::Vector{-15, 9, -21, -3}) == v);
     REQUIRE(la::dehomogenize(la::homogenize(v)) == v);
-}
\ No newline at end of file
+}
+TEST_CASE("vector: double and complex scalars", "[vector]")
+{
+    la::BasicVector<double> v{1e-9, 2.0, 3.0};
+    la::BasicVector<double> w = 2.0 * v - v;
+    REQUIRE(la::approxEqual(w, v));
+    REQUIRE_FALSE(la::approxEqual(v, la::BasicVector<double>{1.1e-9, 2.0, 3.0}));
+    REQUIRE(la::dehomogenize(la::homogenize(v)) == v);
+
+    using Complex = std::complex<double>;
+    la::BasicVector<Complex> z{{1, 2}, {3, -4}};
+    la::BasicVector<Complex> iz = Complex(0, 1) * z;
+    REQUIRE(iz == la::BasicVector<Complex>{{-2, 1}, {4, 3}});
+    REQUIRE(la::round(la::BasicVector<Complex>{{0.9999999999999, -2}})
+            == la::BasicVector<Complex>{{1, -2}});
+}
+
+TEST_CASE("vector: short vectors are stored inline", "[vector]")
+{
+    REQUIRE(la::Vector::inlineCapacity() == 8);
+    std::size_t heap = la::heapAllocations();
+    la::Vector v{1, 2, 3, 4, 5, 6, 7, 8};
+    la::Vector w = v * 2.0F + v;
+    REQUIRE(la::heapAllocations() == heap);
+    REQUIRE(w == la::Vector{3, 6, 9, 12, 15, 18, 21, 24});
+
+    // Copies own their entries.
+    la::Vector u = v;
+    u[0] = -1;
+    REQUIRE(v[0] == 1);
+
+    la::Vector big(la::Vector::inlineCapacity() + 1, 1.0F);
+    REQUIRE(la::heapAllocations() == heap + 1);
+    REQUIRE(la::Vector(big) == big);
+}
@@ -0,0 +1,207 @@
+#include "inc/catch.h"
+#include "inc/matrix.h"
+#include "inc/vector.h"
+#include "inc/view.h"
+#include <cmath>
+#include <complex>
+
+namespace
+{
+
+la::Matrix sample()
+{
+    return la::Matrix::fromRows(
+        {
+            { 1,  2,  3,  4},
+            { 5,  6,  7,  8},
+            { 9, 10, 11, 12}
+        });
+}
+
+}  // namespace
+
+TEST_CASE("view: matrix storage is contiguous", "[view]")
+{
+    la::Matrix A = sample();
+    REQUIRE(A.ld() == A.rows());
+    REQUIRE(A.data() == &A[0][0]);
+    REQUIRE(&A[1][0] == A.data() + A.ld());
+    REQUIRE(A(1, 2) == 7);
+    A(1, 2) = -7;
+    REQUIRE(A[2][1] == -7);
+}
+
+TEST_CASE("view: rows, columns and diagonals", "[view]")
+{
+    la::Matrix A = sample();
+    la::VectorView r = A.row(1);
+    REQUIRE(r.size() == 4);
+    REQUIRE(r.stride() == A.ld());
+    REQUIRE(la::Vector(r) == la::Vector{5, 6, 7, 8});
+    REQUIRE(la::Vector(A.col(2)) == la::Vector{3, 7, 11});
+    REQUIRE(la::Vector(A.diag()) == la::Vector{1, 6, 11});
+
+    // Writes go through to the matrix.
+    r[3] = 0;
+    la::fill(A.diag(), 0.0F);
+    REQUIRE(A == la::Matrix::fromRows(
+        {
+            { 0,  2,  3,  4},
+            { 5,  0,  7,  0},
+            { 9, 10,  0, 12}
+        }));
+
+    // Views of a const matrix are read-only.
+    const la::Matrix& C = A;
+    la::ConstVectorView c = C.row(2);
+    REQUIRE(c[1] == 10);
+}
+
+TEST_CASE("view: blocks", "[view]")
+{
+    la::Matrix A = sample();
+    la::MatrixView B = A.block(1, 1, 2, 3);
+    REQUIRE(B.rows() == 2);
+    REQUIRE(B.cols() == 3);
+    REQUIRE(B.ld() == A.ld());
+    REQUIRE(B(0, 0) == 6);
+    REQUIRE(la::Vector(B.row(1)) == la::Vector{10, 11, 12});
+
+    // Blocks of blocks still refer to A.
+    la::MatrixView D = B.block(1, 1, 1, 2);
+    la::scale(2.0F, D);
+    REQUIRE(A(2, 2) == 22);
+    REQUIRE(A(2, 3) == 24);
+
+    REQUIRE(la::Matrix(B) == la::partition(A, {1, 1}, {2, 3}));
+    la::copy(A.block(0, 0, 1, 2), A.block(2, 2, 1, 2));
+    REQUIRE(la::Vector(A.row(2)) == la::Vector{9, 10, 1, 2});
+}
+
+TEST_CASE("view: kernels", "[view]")
+{
+    la::Matrix A = sample();
+    la::Vector x{1, 0, -1, 2};
+    la::Vector y(3, 1.0F);
+    la::gemv(1.0F, A, x, 2.0F, y);
+    REQUIRE(y == A * x + la::Vector(3, 2.0F));
+
+    REQUIRE(la::dot(A.row(1), x) == 5 - 7 + 16);
+    REQUIRE(la::dot(A.col(3), A.col(0)) == 4 + 40 + 108);
+
+    la::Vector z(3, 0.0F);
+    la::axpy(-1.0F, A.col(0), z);
+    REQUIRE(z == la::Vector{-1, -5, -9});
+
+    // y = A^T v via a transposed traversal of rows.
+    la::Vector v{1, 1, 1};
+    la::Vector w(4, 0.0F);
+    for (int i = 0; i < A.rows(); ++i)
+    {
+        la::axpy(v[i], A.row(i), w);
+    }
+    REQUIRE(w == la::Vector{15, 18, 21, 24});
+}
+
+TEST_CASE("view: deletions use block copies", "[view]")
+{
+    la::Matrix A = sample();
+    REQUIRE(la::deleteRow(A, 0) == la::Matrix(A.block(1, 0, 2, 4)));
+    REQUIRE(la::deleteCol(A, 3) == la::Matrix(A.block(0, 0, 3, 3)));
+    REQUIRE(la::deleteRowAndCol(A, 1, 1) == la::Matrix::fromRows(
+        {
+            { 1,  3,  4},
+            { 9, 11, 12}
+        }));
+}
+
+TEST_CASE("view: complex views", "[view]")
+{
+    using C = std::complex<double>;
+    la::BasicMatrix<C> A(2, 2, C(0, 0));
+    la::fill(A.diag(), C(0, 1));
+    REQUIRE(A(1, 1) == C(0, 1));
+    REQUIRE(la::dot(A.diag(), A.diag()) == C(-2, 0));
+    REQUIRE(la::approxEqual(A.row(0), A.col(0)));
+}
+
+TEST_CASE("view: gemm orientations", "[view]")
+{
+    la::Matrix A = la::Matrix::random(5, 3);
+    la::Matrix B = la::Matrix::random(3, 4);
+    la::Matrix C0 = la::Matrix::random(5, 4);
+    la::Matrix AT = la::transpose(A);
+    la::Matrix BT = la::transpose(B);
+    la::Matrix expected = 2.0F * (A * B) - 0.5F * C0;
+
+    la::Matrix C = C0;
+    la::gemm(la::Op::NoTrans, la::Op::NoTrans, 2.0F, A, B, -0.5F, C);
+    REQUIRE(la::approxEqual(C, expected));
+    C = C0;
+    la::gemm(la::Op::Trans, la::Op::NoTrans, 2.0F, AT, B, -0.5F, C);
+    REQUIRE(la::approxEqual(C, expected));
+    C = C0;
+    la::gemm(la::Op::NoTrans, la::Op::Trans, 2.0F, A, BT, -0.5F, C);
+    REQUIRE(la::approxEqual(C, expected));
+    C = C0;
+    la::gemm(la::Op::Trans, la::Op::Trans, 2.0F, AT, BT, -0.5F, C);
+    REQUIRE(la::approxEqual(C, expected));
+}
+
+TEST_CASE("view: gemm accumulates into blocks", "[view]")
+{
+    la::Matrix A = sample();
+    la::Matrix C(4, 4, 1.0F);
+
+    // C(1:3, 1:3) += A(:, 0:2)^T A(:, 1:3)
+    la::gemm(la::Op::Trans, la::Op::NoTrans, 1.0F, A.block(0, 0, 3, 3),
+             A.block(0, 1, 3, 3), 1.0F, C.block(1, 1, 3, 3));
+    REQUIRE(C(0, 0) == 1);
+    REQUIRE(C(1, 1) == 1 + 1 * 2 + 5 * 6 + 9 * 10);
+    REQUIRE(C(3, 3) == 1 + 3 * 4 + 7 * 8 + 11 * 12);
+
+    // With beta = 0, C is overwritten even if it holds NaNs.
+    la::Matrix N(3, 3, std::nanf(""));
+    la::gemm(la::Op::NoTrans, la::Op::NoTrans, 1.0F, A.block(0, 0, 3, 3),
+             la::Matrix::identity(3), 0.0F, N);
+    REQUIRE(N == la::Matrix(A.block(0, 0, 3, 3)));
+}
+
+TEST_CASE("view: approximate comparison kernels", "[view]")
+{
+    // Long enough to span several blocks, with an odd-sized tail.
+    int n = 1001;
+    la::BasicMatrix<double> A = la::BasicMatrix<double>::random(n, 3);
+    la::BasicMatrix<double> B = A;
+    REQUIRE(la::approxEqual(A, B));
+    REQUIRE(la::approxEqualUlps(A, B, 0));
+    REQUIRE(la::maxError(A, B) == 0);
+    REQUIRE(la::maxUlpDistance(A, B) == 0);
+
+    B(n - 1, 2) = std::nextafter(A(n - 1, 2), 2.0);
+    B(n - 1, 2) = std::nextafter(B(n - 1, 2), 2.0);
+    REQUIRE(la::approxEqual(A, B));
+    REQUIRE_FALSE(la::approxEqualUlps(A, B, 1));
+    REQUIRE(la::approxEqualUlps(A, B, 2));
+    REQUIRE(la::maxUlpDistance(A, B) == 2);
+
+    B(700, 1) += 1e-6;
+    double e = la::maxError(A, B);
+    REQUIRE(e > 0);
+    REQUIRE_FALSE(la::approxEqual(A, B, e));
+    REQUIRE(la::approxEqual(A, B, 1.01 * e));
+
+    // NaNs never compare equal and dominate the error.
+    B(5, 0) = std::nan("");
+    REQUIRE_FALSE(la::approxEqual(A, B, 1.0));
+    REQUIRE(std::isnan(la::maxError(A, B)));
+
+    // Rows are strided vectors.
+    la::Matrix F = la::Matrix::random(9, 9);
+    la::Matrix G = F;
+    G(4, 7) += 1;
+    REQUIRE(la::approxEqual(F.row(3), G.row(3)));
+    REQUIRE_FALSE(la::approxEqual(F.row(4), G.row(4)));
+    REQUIRE(la::maxUlpDistance(F.col(7), G.col(7)) > 0);
+    REQUIRE_FALSE(la::approxEqual(F.block(0, 0, 9, 8), G.block(0, 0, 9, 9)));
+}
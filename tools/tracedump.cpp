@@ -0,0 +1,156 @@
+#include "inc/trace.h"
+#include <algorithm>  // max()
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>  // iota()
+#include <string>
+#include <utility>  // swap()
+#include <vector>
+
+namespace
+{
+
+using la::trace::Event;
+using la::trace::EventType;
+
+void printValue(const Event& e)
+{
+    if (e.im == 0.0)
+    {
+        std::printf("%.9g", e.re);
+    }
+    else
+    {
+        std::printf("(%.9g,%.9g)", e.re, e.im);
+    }
+}
+
+void printEvent(const Event& e)
+{
+    std::printf("%llu ", static_cast<unsigned long long>(e.seq));
+    switch (e.type)
+    {
+    case EventType::Swap:
+        std::printf("swap R%d and R%d", e.row1, e.row2);
+        break;
+    case EventType::Scale:
+        std::printf("scale R%d by ", e.row1);
+        printValue(e);
+        break;
+    case EventType::Replace:
+        std::printf("replace R%d with R%d + (", e.row1, e.row1);
+        printValue(e);
+        std::printf(" * R%d)", e.row2);
+        break;
+    case EventType::Pivot:
+        std::printf("pivot R%d for C%d, value ", e.row1, e.col);
+        printValue(e);
+        std::printf("\n");
+        return;
+    default:
+        std::printf("unknown event %d\n", static_cast<int>(e.type));
+        return;
+    }
+    std::printf(" from C%d\n", e.col);
+}
+
+/**
+ * Prints operation counts, the range of pivot magnitudes and the largest
+ * multiplier, then replays the swaps to show where each row ended up.
+ */
+void printSummary(const std::vector<Event>& events, unsigned long long dropped)
+{
+    long counts[5] = {0, 0, 0, 0, 0};
+    double minPivot = HUGE_VAL, maxPivot = 0.0, maxFactor = 0.0;
+    int rows = 0;
+    for (const Event& e : events)
+    {
+        int t = static_cast<int>(e.type);
+        counts[(t >= 1 && t <= 4) ? t : 0] += 1;
+        double mag = std::hypot(e.re, e.im);
+        if (e.type == EventType::Pivot)
+        {
+            minPivot = std::min(minPivot, mag);
+            maxPivot = std::max(maxPivot, mag);
+        }
+        else if (e.type == EventType::Replace)
+        {
+            maxFactor = std::max(maxFactor, mag);
+        }
+        rows = std::max(rows, std::max(e.row1, e.row2) + 1);
+    }
+    std::printf("events: %zu (%llu dropped)\n", events.size(), dropped);
+    std::printf("swaps: %ld, scales: %ld, replaces: %ld, pivots: %ld",
+                counts[1], counts[2], counts[3], counts[4]);
+    if (counts[0] > 0)
+    {
+        std::printf(", unknown: %ld", counts[0]);
+    }
+    std::printf("\n");
+    if (counts[4] > 0)
+    {
+        std::printf("pivot magnitude: min %.9g, max %.9g\n", minPivot,
+                    maxPivot);
+    }
+    if (counts[3] > 0)
+    {
+        std::printf("largest multiplier: %.9g\n", maxFactor);
+    }
+
+    // order[i] is the original row now in position i.
+    std::vector<int> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    for (const Event& e : events)
+    {
+        if (e.type == EventType::Swap)
+        {
+            std::swap(order[e.row1], order[e.row2]);
+        }
+    }
+    std::printf("row order after swaps:");
+    for (int r : order)
+    {
+        std::printf(" %d", r);
+    }
+    std::printf("\n");
+}
+
+}  // namespace
+
+/**
+ * Decodes a trace file written by la::trace::save() and prints its events,
+ * one per line, or a summary of them.
+ */
+int main(int argc, char* argv[])
+{
+    bool summary = argc == 3 && std::strcmp(argv[1], "--summary") == 0;
+    if (argc != 2 && !summary)
+    {
+        std::fprintf(stderr, "usage: %s [--summary] TRACE_FILE\n", argv[0]);
+        return 1;
+    }
+    std::vector<Event> events;
+    std::uint64_t dropped;
+    if (!la::trace::load(argv[argc - 1], events, dropped))
+    {
+        std::fprintf(stderr, "%s: cannot read trace file %s\n", argv[0],
+                     argv[argc - 1]);
+        return 1;
+    }
+    if (summary)
+    {
+        printSummary(events, dropped);
+        return 0;
+    }
+    if (dropped > 0)
+    {
+        std::printf("# %llu earlier events were dropped\n",
+                    static_cast<unsigned long long>(dropped));
+    }
+    for (const Event& e : events)
+    {
+        printEvent(e);
+    }
+    return 0;
+}